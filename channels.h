@@ -44,6 +44,10 @@
 #include "rrlib/data_fusion/policies/channel/LastValue.h"
 #include "rrlib/data_fusion/policies/channel/Average.h"
 #include "rrlib/data_fusion/policies/channel/Median.h"
+#include "rrlib/data_fusion/policies/channel/ExponentialAverage.h"
+#include "rrlib/data_fusion/policies/channel/Quantile.h"
+#include "rrlib/data_fusion/policies/channel/SlidingWindow.h"
+#include "rrlib/data_fusion/policies/channel/Dense.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
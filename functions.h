@@ -37,11 +37,17 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <array>
+#include <iterator>
 #include <stdexcept>
+#include <vector>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/tFusionResult.h"
 #include "rrlib/data_fusion/tMaximumKey.h"
 #include "rrlib/data_fusion/tAverage.h"
 #include "rrlib/data_fusion/tWeightedAverage.h"
@@ -66,91 +72,169 @@ namespace data_fusion
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
 
+//! Number of samples up to which the median helpers keep their scratch range on the stack
+const size_t cMEDIAN_STACK_CAPACITY = 32;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Scratch range for the median kernels that is kept on the stack for small inputs
+template <typename TValue, size_t Tstack_capacity = cMEDIAN_STACK_CAPACITY>
+class tScratchBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tScratchBuffer(size_t size)
+  {
+    if (size > Tstack_capacity)
+    {
+      this->heap.resize(size);
+    }
+  }
+
+  inline TValue *Begin()
+  {
+    return this->heap.empty() ? this->stack.data() : this->heap.data();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::array<TValue, Tstack_capacity> stack;
+  std::vector<TValue, tAllocator<TValue>> heap;
+
+};
+
 //----------------------------------------------------------------------
 // Function declaration
 //----------------------------------------------------------------------
+[[noreturn]] RRLIB_DATA_FUSION_COLD inline void ThrowEmptySamples()
+{
+  throw std::logic_error("Given empty list of samples!");
+}
 
+[[noreturn]] RRLIB_DATA_FUSION_COLD inline void ThrowKeyMismatch()
+{
+  throw std::runtime_error("Number of samples did not match number of keys!");
+}
 
+[[noreturn]] RRLIB_DATA_FUSION_COLD inline void ThrowScratchTooSmall()
+{
+  throw std::logic_error("Scratch range is smaller than the list of samples!");
+}
 
-template <typename TSample, typename TSampleIterator, typename TKeyIterator>
-inline const TSample FuseValuesUsingMaximumKey(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
+template <typename TSampleIterator>
+inline void CheckSamples(TSampleIterator begin_samples, TSampleIterator end_samples)
 {
-  tMaximumKey<TSample> fuser;
-  if (begin_samples == end_samples)
+  if (RRLIB_DATA_FUSION_UNLIKELY(begin_samples == end_samples))
   {
-    throw std::logic_error("Given empty list of samples!");
+    ThrowEmptySamples();
   }
-  fuser.SetNumberOfChannels(std::distance(begin_samples, end_samples));
-  fuser.UpdateAllChannels(begin_samples, end_samples, begin_keys, end_keys);
-  return fuser.FusedValue();
 }
 
-template <typename TSample, typename TSampleIterator>
-inline const TSample FuseValuesUsingAverage(TSampleIterator begin_samples, TSampleIterator end_samples)
+template <typename TSampleIterator, typename TKeyIterator>
+inline void CheckSamples(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
 {
-  tAverage<TSample> fuser;
-  if (begin_samples == end_samples)
+  CheckSamples(begin_samples, end_samples);
+  if (RRLIB_DATA_FUSION_UNLIKELY(std::distance(begin_samples, end_samples) != std::distance(begin_keys, end_keys)))
   {
-    throw std::logic_error("Given empty list of samples!");
+    ThrowKeyMismatch();
   }
-  fuser.SetNumberOfChannels(std::distance(begin_samples, end_samples));
-  fuser.UpdateAllChannels(begin_samples, end_samples);
-  return fuser.FusedValue();
 }
 
-template <typename TSample, typename TSampleIterator, typename TKeyIterator>
-inline const TSample FuseValuesUsingWeightedAverage(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
+template <typename TSampleIterator, typename TScratchIterator>
+inline void CheckScratch(TSampleIterator begin_samples, TSampleIterator end_samples, TScratchIterator begin_scratch, TScratchIterator end_scratch)
 {
-  tWeightedAverage<TSample> fuser;
-  if (begin_samples == end_samples)
+  if (RRLIB_DATA_FUSION_UNLIKELY(std::distance(begin_scratch, end_scratch) < std::distance(begin_samples, end_samples)))
   {
-    throw std::logic_error("Given empty list of samples!");
+    ThrowScratchTooSmall();
   }
-  fuser.SetNumberOfChannels(std::distance(begin_samples, end_samples));
-  fuser.UpdateAllChannels(begin_samples, end_samples, begin_keys, end_keys);
-  return fuser.FusedValue();
+}
+
+}
+
+/*! The FuseValuesUsing* functions fuse a range of samples (and keys) in
+ *  one shot like the corresponding fuser with a channel per sample. They
+ *  call the kernels in kernels.h. Only the median helpers need scratch
+ *  memory. Up to cMEDIAN_STACK_CAPACITY samples it is on the stack, for
+ *  more samples it is allocated from the default memory resource (see
+ *  tScopedMemoryResource). The overloads with a scratch range never
+ *  allocate.
+ */
+template <typename TSample, typename TSampleIterator, typename TKeyIterator>
+inline const TSample FuseValuesUsingMaximumKey(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
+{
+  internal::CheckSamples(begin_samples, end_samples, begin_keys, end_keys);
+  return kernels::MaximumKey<TSample>(begin_samples, end_samples, begin_keys);
+}
+
+template <typename TSample, typename TSampleIterator>
+inline const TSample FuseValuesUsingAverage(TSampleIterator begin_samples, TSampleIterator end_samples)
+{
+  internal::CheckSamples(begin_samples, end_samples);
+  return kernels::Average<TSample>(begin_samples, end_samples);
+}
+
+template <typename TSample, typename TSampleIterator, typename TKeyIterator>
+inline const TSample FuseValuesUsingWeightedAverage(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
+{
+  internal::CheckSamples(begin_samples, end_samples, begin_keys, end_keys);
+  return kernels::WeightedAverage<TSample>(begin_samples, end_samples, begin_keys);
 }
 
 template <typename TSample, typename TSampleIterator, typename TKeyIterator>
 inline const TSample FuseValuesUsingWeightedSum(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
 {
-  tWeightedSum<TSample> fuser;
-  if (begin_samples == end_samples)
-  {
-    throw std::logic_error("Given empty list of samples!");
-  }
-  fuser.SetNumberOfChannels(std::distance(begin_samples, end_samples));
-  fuser.UpdateAllChannels(begin_samples, end_samples, begin_keys, end_keys);
-  return fuser.FusedValue();
+  internal::CheckSamples(begin_samples, end_samples, begin_keys, end_keys);
+  return kernels::WeightedSum<TSample>(begin_samples, end_samples, begin_keys);
 }
 
 template <typename TSample, typename TSampleIterator>
 inline const TSample FuseValuesUsingMedianVoter(TSampleIterator begin_samples, TSampleIterator end_samples)
 {
-  tMedianVoter<TSample> fuser;
-  if (begin_samples == end_samples)
-  {
-    throw std::logic_error("Given empty list of samples!");
-  }
-  fuser.SetNumberOfChannels(std::distance(begin_samples, end_samples));
-  fuser.UpdateAllChannels(begin_samples, end_samples);
-  return fuser.FusedValue();
+  internal::CheckSamples(begin_samples, end_samples);
+  internal::tScratchBuffer<TSample> scratch(std::distance(begin_samples, end_samples));
+  return kernels::Median<TSample>(begin_samples, end_samples, scratch.Begin());
+}
+
+//! Uses the given scratch range, which must have room for a copy of the samples
+template <typename TSample, typename TSampleIterator, typename TScratchIterator>
+inline const TSample FuseValuesUsingMedianVoter(TSampleIterator begin_samples, TSampleIterator end_samples, TScratchIterator begin_scratch, TScratchIterator end_scratch)
+{
+  internal::CheckSamples(begin_samples, end_samples);
+  internal::CheckScratch(begin_samples, end_samples, begin_scratch, end_scratch);
+  return kernels::Median<TSample>(begin_samples, end_samples, begin_scratch);
 }
 
 template <typename TSample, typename TSampleIterator, typename TKeyIterator>
 inline const TSample FuseValuesUsingMedianKeyVoter(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
 {
-  tMedianKeyVoter<TSample> fuser;
-  if (begin_samples == end_samples)
-  {
-    throw std::logic_error("Given empty list of samples!");
-  }
-  fuser.SetNumberOfChannels(std::distance(begin_samples, end_samples));
-  fuser.UpdateAllChannels(begin_samples, end_samples, begin_keys, end_keys);
-  return fuser.FusedValue();
+  internal::CheckSamples(begin_samples, end_samples, begin_keys, end_keys);
+  internal::tScratchBuffer<kernels::tIndexedKey> scratch(std::distance(begin_keys, end_keys));
+  TSampleIterator median = begin_samples;
+  std::advance(median, kernels::MedianKeyIndex(begin_keys, end_keys, scratch.Begin()));
+  return *median;
 }
 
-
+//! Uses the given scratch range, which must have room for an indexed copy of the keys
+template <typename TSample, typename TSampleIterator, typename TKeyIterator, typename TScratchIterator>
+inline const TSample FuseValuesUsingMedianKeyVoter(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys, TScratchIterator begin_scratch, TScratchIterator end_scratch)
+{
+  internal::CheckSamples(begin_samples, end_samples, begin_keys, end_keys);
+  internal::CheckScratch(begin_keys, end_keys, begin_scratch, end_scratch);
+  TSampleIterator median = begin_samples;
+  std::advance(median, kernels::MedianKeyIndex(begin_keys, end_keys, begin_scratch));
+  return *median;
+}
 
 //----------------------------------------------------------------------
 // End of namespace declaration
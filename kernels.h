@@ -0,0 +1,273 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    kernels.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Stateless fusion algorithms over ranges of samples and keys
+ *
+ * The fusers and the FuseValuesUsing* functions are implemented with
+ * these kernels. They neither allocate memory nor log and have no
+ * virtual calls, so one-shot fusion only costs the arithmetic. Samples
+ * of types whose operator+= does not add component-wise (angles and
+ * poses) are accumulated per component (see tAccumulator).
+ *
+ * All ranges must be non-empty and key ranges must have at least as many
+ * elements as the sample range. The medians need a scratch range with
+ * one element per sample that they may reorder.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__kernels_h__
+#define __rrlib__data_fusion__kernels_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tAccumulator.h"
+#include "rrlib/data_fusion/selection.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace kernels
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+typedef std::pair<double, size_t> tIndexedKey;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Forward iterator over the samples or keys of a range of channels
+template <typename TChannelIterator, bool Tkeys>
+class tChannelIterator
+{
+  typedef decltype(std::declval<TChannelIterator>()->GetSample()) tSampleReference;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::forward_iterator_tag iterator_category;
+  typedef typename std::decay<typename std::conditional<Tkeys, double, tSampleReference>::type>::type value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const value_type *pointer;
+  typedef const value_type reference;
+
+  explicit tChannelIterator(TChannelIterator channel)
+    : channel(channel)
+  {}
+
+  inline reference operator*() const
+  {
+    return this->Get(std::integral_constant<bool, Tkeys>());
+  }
+
+  inline tChannelIterator &operator++()
+  {
+    ++this->channel;
+    return *this;
+  }
+
+  inline tChannelIterator operator++(int)
+  {
+    tChannelIterator result(*this);
+    ++this->channel;
+    return result;
+  }
+
+  inline bool operator==(const tChannelIterator &other) const
+  {
+    return this->channel == other.channel;
+  }
+
+  inline bool operator!=(const tChannelIterator &other) const
+  {
+    return this->channel != other.channel;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  TChannelIterator channel;
+
+  inline reference Get(std::false_type) const
+  {
+    return this->channel->GetSample();
+  }
+
+  inline reference Get(std::true_type) const
+  {
+    return this->channel->GetKey();
+  }
+
+};
+
+}
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+//! Iterator over the samples of the channels starting at channel
+template <typename TChannelIterator>
+inline internal::tChannelIterator<TChannelIterator, false> ChannelSamples(TChannelIterator channel)
+{
+  return internal::tChannelIterator<TChannelIterator, false>(channel);
+}
+
+//! Iterator over the keys of the channels starting at channel
+template <typename TChannelIterator>
+inline internal::tChannelIterator<TChannelIterator, true> ChannelKeys(TChannelIterator channel)
+{
+  return internal::tChannelIterator<TChannelIterator, true>(channel);
+}
+
+//! The sample with the largest key (the first one if there are several)
+template <typename TSample, typename TSampleIterator, typename TKeyIterator>
+inline const TSample MaximumKey(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys)
+{
+  TSample result = *begin_samples;
+  double maximum_key = *begin_keys;
+  for (++begin_samples, ++begin_keys; begin_samples != end_samples; ++begin_samples, ++begin_keys)
+  {
+    if (*begin_keys > maximum_key)
+    {
+      result = *begin_samples;
+      maximum_key = *begin_keys;
+    }
+  }
+  return result;
+}
+
+template <typename TSample, typename TSampleIterator>
+inline const TSample Average(TSampleIterator begin_samples, TSampleIterator end_samples)
+{
+  tAccumulator<TSample> accumulator;
+  size_t number_of_samples = 0;
+  for (; begin_samples != end_samples; ++begin_samples, ++number_of_samples)
+  {
+    accumulator.Add(*begin_samples);
+  }
+  return accumulator.Result(1.0 / number_of_samples);
+}
+
+//! Average weighted with the keys, or the plain average if all keys are zero
+template <typename TSample, typename TSampleIterator, typename TKeyIterator>
+inline const TSample WeightedAverage(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys)
+{
+  bool use_keys = false;
+  TKeyIterator key = begin_keys;
+  for (TSampleIterator sample = begin_samples; sample != end_samples && !use_keys; ++sample, ++key)
+  {
+    use_keys = *key != 0.0;
+  }
+
+  tAccumulator<TSample> accumulator;
+  double accumulated_weights = 0;
+  for (key = begin_keys; begin_samples != end_samples; ++begin_samples, ++key)
+  {
+    double weight = use_keys ? static_cast<double>(*key) : 1.0;
+    accumulator.Add(*begin_samples, weight);
+    accumulated_weights += weight;
+  }
+  return accumulator.Result(1.0 / accumulated_weights);
+}
+
+//! Sum of the samples weighted with their keys relative to the largest key
+template <typename TSample, typename TSampleIterator, typename TKeyIterator>
+inline const TSample WeightedSum(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys)
+{
+  double maximum_key = 0;
+  TKeyIterator key = begin_keys;
+  for (TSampleIterator sample = begin_samples; sample != end_samples; ++sample, ++key)
+  {
+    maximum_key = std::max(maximum_key, static_cast<double>(*key));
+  }
+
+  tAccumulator<TSample> accumulator;
+  if (maximum_key != 0.0)
+  {
+    for (key = begin_keys; begin_samples != end_samples; ++begin_samples, ++key)
+    {
+      accumulator.Add(*begin_samples, *key / maximum_key);
+    }
+  }
+  return accumulator.Result(1.0);
+}
+
+//! Copies the samples to scratch and selects their median there
+template <typename TSample, typename TSampleIterator, typename TScratchIterator>
+inline const TSample Median(TSampleIterator begin_samples, TSampleIterator end_samples, TScratchIterator scratch, tSelectionAlgorithm algorithm = tSelectionAlgorithm::INTROSELECT)
+{
+  TScratchIterator end_scratch = std::copy(begin_samples, end_samples, scratch);
+  return *selection::SelectMedian(scratch, end_scratch, std::less<TSample>(), algorithm);
+}
+
+//! Index of the sample with the median key, using scratch for the keys and their indices
+template <typename TKeyIterator, typename TScratchIterator>
+inline size_t MedianKeyIndex(TKeyIterator begin_keys, TKeyIterator end_keys, TScratchIterator scratch, tSelectionAlgorithm algorithm = tSelectionAlgorithm::INTROSELECT)
+{
+  TScratchIterator end_scratch = scratch;
+  for (size_t index = 0; begin_keys != end_keys; ++begin_keys, ++end_scratch, ++index)
+  {
+    *end_scratch = tIndexedKey(*begin_keys, index);
+  }
+  return selection::SelectMedian(scratch, end_scratch, std::less<tIndexedKey>(), algorithm)->second;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
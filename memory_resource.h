@@ -0,0 +1,522 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    memory_resource.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Memory resources for the containers of this library
+ *
+ * A minimal C++11 counterpart of std::pmr. The containers used by
+ * channels and fusers allocate through tAllocator. It takes its memory
+ * resource from the calling thread's default resource at construction
+ * time. That resource can be replaced within a scope, e.g. by a
+ * tMonotonicBufferResource that serves all allocations of a control
+ * cycle from one arena.
+ *
+ * The fusion classes also take a resource as constructor argument, which
+ * they use for all their memory. Every fuser additionally owns an arena
+ * on top of that resource for the scratch buffers of a single timestep.
+ * EnterNextTimestep releases this arena.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__memory_resource_h__
+#define __rrlib__data_fusion__memory_resource_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tMemoryResource;
+
+inline tMemoryResource &NewDeleteResource();
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Interface of memory resources
+class tMemoryResource
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  virtual ~tMemoryResource()
+  {}
+
+  virtual void *Allocate(size_t size, size_t alignment) = 0;
+
+  virtual void Deallocate(void *pointer, size_t size, size_t alignment) = 0;
+
+};
+
+//! Memory resource using global operator new and delete
+class tNewDeleteResource : public tMemoryResource
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  virtual void *Allocate(size_t size, size_t)
+  {
+    return ::operator new(size);
+  }
+
+  virtual void Deallocate(void *pointer, size_t, size_t)
+  {
+    ::operator delete(pointer);
+  }
+
+};
+
+//! Arena that hands out memory by advancing a pointer
+/*! Deallocate does nothing, memory is only returned by Release, which
+ *  makes the whole arena available again. The arena first uses the
+ *  buffer given to the constructor (if any) and then requests chunks of
+ *  growing size from the upstream resource. Release keeps the largest
+ *  chunk, so a cycle with the same allocations as the previous one does
+ *  not touch the upstream resource.
+ *
+ *  Containers allocated from the arena must not be used after Release.
+ */
+class tMonotonicBufferResource : public tMemoryResource
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMonotonicBufferResource(tMemoryResource &upstream = NewDeleteResource())
+    : upstream(&upstream),
+      initial_buffer(0),
+      initial_size(0),
+      chunks(0),
+      next_chunk_size(cMINIMUM_CHUNK_SIZE)
+  {
+    this->Reset();
+  }
+
+  tMonotonicBufferResource(void *buffer, size_t size, tMemoryResource &upstream = NewDeleteResource())
+    : upstream(&upstream),
+      initial_buffer(static_cast<char *>(buffer)),
+      initial_size(size),
+      chunks(0),
+      next_chunk_size(size > cMINIMUM_CHUNK_SIZE ? size : cMINIMUM_CHUNK_SIZE)
+  {
+    this->Reset();
+  }
+
+  ~tMonotonicBufferResource()
+  {
+    this->FreeChunks(0);
+  }
+
+  virtual void *Allocate(size_t size, size_t alignment)
+  {
+    char *aligned = Align(this->current, alignment);
+    if (!aligned || aligned + size > this->end)
+    {
+      this->AddChunk(size + alignment);
+      aligned = Align(this->current, alignment);
+    }
+    this->current = aligned + size;
+    return aligned;
+  }
+
+  virtual void Deallocate(void *, size_t, size_t)
+  {}
+
+  //! Releases all memory handed out so far
+  void Release()
+  {
+    tChunk *largest = this->chunks;
+    this->FreeChunks(largest);
+    this->chunks = largest;
+    if (largest)
+    {
+      largest->next = 0;
+      this->current = reinterpret_cast<char *>(largest + 1);
+      this->end = this->current + largest->size;
+    }
+    else
+    {
+      this->Reset();
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static const size_t cMINIMUM_CHUNK_SIZE = 1024;
+
+  struct tChunk
+  {
+    tChunk *next;
+    size_t size;
+    std::max_align_t alignment;
+  };
+
+  tMemoryResource *upstream;
+  char *initial_buffer;
+  size_t initial_size;
+  tChunk *chunks;
+  size_t next_chunk_size;
+  char *current;
+  char *end;
+
+  tMonotonicBufferResource(const tMonotonicBufferResource &);
+  tMonotonicBufferResource &operator=(const tMonotonicBufferResource &);
+
+  static inline char *Align(char *pointer, size_t alignment)
+  {
+    if (!pointer)
+    {
+      return 0;
+    }
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    return pointer + ((alignment - address % alignment) % alignment);
+  }
+
+  void Reset()
+  {
+    this->current = this->initial_buffer;
+    this->end = this->initial_buffer + this->initial_size;
+  }
+
+  //! The newest chunk is the largest one and always first in the list
+  void AddChunk(size_t minimum_size)
+  {
+    size_t size = std::max(this->next_chunk_size, minimum_size);
+    tChunk *chunk = static_cast<tChunk *>(this->upstream->Allocate(sizeof(tChunk) + size, alignof(tChunk)));
+    chunk->next = this->chunks;
+    chunk->size = size;
+    this->chunks = chunk;
+    this->current = reinterpret_cast<char *>(chunk + 1);
+    this->end = this->current + size;
+    this->next_chunk_size = size * 2;
+  }
+
+  void FreeChunks(tChunk *keep)
+  {
+    for (tChunk *chunk = this->chunks; chunk;)
+    {
+      tChunk *next = chunk->next;
+      if (chunk != keep)
+      {
+        this->upstream->Deallocate(chunk, sizeof(tChunk) + chunk->size, alignof(tChunk));
+      }
+      chunk = next;
+    }
+    this->chunks = 0;
+  }
+
+};
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+inline tMemoryResource &NewDeleteResource()
+{
+  static tNewDeleteResource resource;
+  return resource;
+}
+
+namespace internal
+{
+inline tMemoryResource *&DefaultMemoryResource()
+{
+  static thread_local tMemoryResource *resource = &NewDeleteResource();
+  return resource;
+}
+}
+
+//! The resource used by containers that are constructed by the calling thread
+inline tMemoryResource &GetDefaultMemoryResource()
+{
+  return *internal::DefaultMemoryResource();
+}
+
+//! Replaces the default resource of the calling thread and returns the previous one
+inline tMemoryResource &SetDefaultMemoryResource(tMemoryResource &resource)
+{
+  tMemoryResource &previous = *internal::DefaultMemoryResource();
+  internal::DefaultMemoryResource() = &resource;
+  return previous;
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Makes a resource the default of the calling thread while in scope
+/*! Fusion objects that are created in the scope, and the scratch buffers
+ *  of FuseValuesUsing* for large inputs, allocate all their memory from
+ *  resource.
+ */
+class tScopedMemoryResource
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tScopedMemoryResource(tMemoryResource &resource)
+    : previous(&SetDefaultMemoryResource(resource))
+  {}
+
+  ~tScopedMemoryResource()
+  {
+    SetDefaultMemoryResource(*this->previous);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tMemoryResource *previous;
+
+  tScopedMemoryResource(const tScopedMemoryResource &);
+  tScopedMemoryResource &operator=(const tScopedMemoryResource &);
+
+};
+
+//! Allocator for standard containers that allocates from a tMemoryResource
+/*! A default constructed allocator uses the default resource of the
+ *  calling thread. Copies of a container keep the resource of the
+ *  original.
+ */
+template <typename T>
+class tAllocator
+{
+
+  template <typename U>
+  friend class tAllocator;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef T value_type;
+
+  tAllocator()
+    : resource(&GetDefaultMemoryResource())
+  {}
+
+  tAllocator(tMemoryResource &resource)
+    : resource(&resource)
+  {}
+
+  template <typename U>
+  tAllocator(const tAllocator<U> &other)
+    : resource(other.resource)
+  {}
+
+  inline T *allocate(size_t n)
+  {
+    return static_cast<T *>(this->resource->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  inline void deallocate(T *pointer, size_t n)
+  {
+    this->resource->Deallocate(pointer, n * sizeof(T), alignof(T));
+  }
+
+  inline tMemoryResource &Resource() const
+  {
+    return *this->resource;
+  }
+
+  template <typename U>
+  inline bool operator==(const tAllocator<U> &other) const
+  {
+    return this->resource == other.resource;
+  }
+
+  template <typename U>
+  inline bool operator!=(const tAllocator<U> &other) const
+  {
+    return this->resource != other.resource;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tMemoryResource *resource;
+
+};
+
+/*! Fixed number of default constructed elements allocated from a
+ *  tMemoryResource. Unlike std::vector, it requires neither copyable nor
+ *  movable elements (e.g. std::atomic).
+ */
+template <typename T>
+class tResourceArray
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tResourceArray(tMemoryResource &resource = GetDefaultMemoryResource())
+    : allocator(resource),
+      elements(0),
+      number_of_elements(0)
+  {}
+
+  ~tResourceArray()
+  {
+    this->Clear();
+  }
+
+  inline size_t Size() const
+  {
+    return this->number_of_elements;
+  }
+
+  inline T &operator[](size_t index)
+  {
+    return this->elements[index];
+  }
+
+  inline const T &operator[](size_t index) const
+  {
+    return this->elements[index];
+  }
+
+  //! Replaces the elements by number_of_elements default constructed ones
+  void Reset(size_t number_of_elements)
+  {
+    this->Clear();
+    if (number_of_elements == 0)
+    {
+      return;
+    }
+    T *elements = this->allocator.allocate(number_of_elements);
+    size_t constructed = 0;
+    try
+    {
+      for (; constructed < number_of_elements; ++constructed)
+      {
+        new(elements + constructed) T();
+      }
+    }
+    catch (...)
+    {
+      Destroy(elements, constructed);
+      this->allocator.deallocate(elements, number_of_elements);
+      throw;
+    }
+    this->elements = elements;
+    this->number_of_elements = number_of_elements;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tAllocator<T> allocator;
+  T *elements;
+  size_t number_of_elements;
+
+  tResourceArray(const tResourceArray &);
+  tResourceArray &operator=(const tResourceArray &);
+
+  static void Destroy(T *elements, size_t number_of_elements)
+  {
+    while (number_of_elements > 0)
+    {
+      elements[--number_of_elements].~T();
+    }
+  }
+
+  void Clear()
+  {
+    if (this->elements)
+    {
+      Destroy(this->elements, this->number_of_elements);
+      this->allocator.deallocate(this->elements, this->number_of_elements);
+      this->elements = 0;
+      this->number_of_elements = 0;
+    }
+  }
+
+};
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+//! Default constructs an object whose containers allocate from resource
+/*! Works for every type that takes its allocators from the default
+ *  resource, e.g. containers with tAllocator and arrays of channels.
+ */
+template <typename T>
+inline T ConstructWithResource(tMemoryResource &resource)
+{
+  tScopedMemoryResource scope(resource);
+  return T();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -0,0 +1,107 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    Average.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains Average
+ *
+ * \b Average
+ *
+ * Batched counterpart of tAverage
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__batch__Average_h__
+#define __rrlib__data_fusion__policies__batch__Average_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/simd.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace batch
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Average of the channels of every group (see tAverage)
+template <typename TSample>
+class Average
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit Average(tMemoryResource & = GetDefaultMemoryResource())
+  {}
+
+  void Fuse(const TSample *samples, const double *, size_t number_of_groups, size_t number_of_channels, TSample *fused_values)
+  {
+    std::fill(fused_values, fused_values + number_of_groups, TSample(0));
+    for (size_t channel = 0; channel < number_of_channels; ++channel)
+    {
+      simd::AddTo(fused_values, samples + channel * number_of_groups, number_of_groups);
+    }
+    const double factor = 1.0 / number_of_channels;
+    for (size_t group = 0; group < number_of_groups; ++group)
+    {
+      fused_values[group] = fused_values[group] * factor;
+    }
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
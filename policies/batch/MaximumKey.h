@@ -0,0 +1,115 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    MaximumKey.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains MaximumKey
+ *
+ * \b MaximumKey
+ *
+ * Batched counterpart of tMaximumKey
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__batch__MaximumKey_h__
+#define __rrlib__data_fusion__policies__batch__MaximumKey_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/simd.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace batch
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Sample with the maximum key in every group (see tMaximumKey)
+/*! If several channels share the maximum key, the first one is chosen.
+ */
+template <typename TSample>
+class MaximumKey
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit MaximumKey(tMemoryResource &resource = GetDefaultMemoryResource())
+    : max_keys(tAllocator<double>(resource))
+  {}
+
+  void Fuse(const TSample *samples, const double *keys, size_t number_of_groups, size_t number_of_channels, TSample *fused_values)
+  {
+    this->max_keys.assign(keys, keys + number_of_groups);
+    std::copy(samples, samples + number_of_groups, fused_values);
+    double *max_keys = this->max_keys.data();
+    for (size_t channel = 1; channel < number_of_channels; ++channel)
+    {
+      simd::SelectMaximumKey(max_keys, fused_values, keys + channel * number_of_groups, samples + channel * number_of_groups, number_of_groups);
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<double, tAllocator<double>> max_keys;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
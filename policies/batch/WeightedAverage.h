@@ -0,0 +1,133 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    WeightedAverage.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains WeightedAverage
+ *
+ * \b WeightedAverage
+ *
+ * Batched counterpart of tWeightedAverage
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__batch__WeightedAverage_h__
+#define __rrlib__data_fusion__policies__batch__WeightedAverage_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/simd.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace batch
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Weighted average of the channels of every group (see tWeightedAverage)
+/*! Groups whose keys are all zero fall back to the plain average.
+ */
+template <typename TSample>
+class WeightedAverage
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit WeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : accumulated(tAllocator<TSample>(resource)),
+      accumulated_keys(tAllocator<double>(resource)),
+      accumulated_absolute_keys(tAllocator<double>(resource))
+  {}
+
+  void Fuse(const TSample *samples, const double *keys, size_t number_of_groups, size_t number_of_channels, TSample *fused_values)
+  {
+    this->accumulated.assign(number_of_groups, TSample(0));
+    this->accumulated_keys.assign(number_of_groups, 0);
+    this->accumulated_absolute_keys.assign(number_of_groups, 0);
+    std::fill(fused_values, fused_values + number_of_groups, TSample(0));
+    TSample *accumulated = this->accumulated.data();
+    double *accumulated_keys = this->accumulated_keys.data();
+    double *accumulated_absolute_keys = this->accumulated_absolute_keys.data();
+    for (size_t channel = 0; channel < number_of_channels; ++channel)
+    {
+      const TSample *channel_samples = samples + channel * number_of_groups;
+      const double *channel_keys = keys + channel * number_of_groups;
+      simd::MultiplyAddTo(fused_values, channel_samples, channel_keys, number_of_groups);
+      simd::AddTo(accumulated, channel_samples, number_of_groups);
+      simd::AddTo(accumulated_keys, channel_keys, number_of_groups);
+      simd::AddAbsoluteTo(accumulated_absolute_keys, channel_keys, number_of_groups);
+    }
+    const double factor = 1.0 / number_of_channels;
+    for (size_t group = 0; group < number_of_groups; ++group)
+    {
+      fused_values[group] = this->accumulated_absolute_keys[group] != 0.0 ? fused_values[group] * (1.0 / this->accumulated_keys[group]) : this->accumulated[group] * factor;
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<TSample, tAllocator<TSample>> accumulated;
+  std::vector<double, tAllocator<double>> accumulated_keys;
+  std::vector<double, tAllocator<double>> accumulated_absolute_keys;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
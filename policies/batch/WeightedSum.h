@@ -0,0 +1,121 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    WeightedSum.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains WeightedSum
+ *
+ * \b WeightedSum
+ *
+ * Batched counterpart of tWeightedSum
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__batch__WeightedSum_h__
+#define __rrlib__data_fusion__policies__batch__WeightedSum_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/simd.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace batch
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Sum of the channels of every group weighted relative to the maximum key (see tWeightedSum)
+template <typename TSample>
+class WeightedSum
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit WeightedSum(tMemoryResource &resource = GetDefaultMemoryResource())
+    : max_keys(tAllocator<double>(resource))
+  {}
+
+  void Fuse(const TSample *samples, const double *keys, size_t number_of_groups, size_t number_of_channels, TSample *fused_values)
+  {
+    this->max_keys.assign(number_of_groups, 0);
+    double *max_keys = this->max_keys.data();
+    std::fill(fused_values, fused_values + number_of_groups, TSample(0));
+    for (size_t channel = 0; channel < number_of_channels; ++channel)
+    {
+      const double *channel_keys = keys + channel * number_of_groups;
+      simd::MaximumTo(max_keys, channel_keys, number_of_groups);
+      simd::MultiplyAddTo(fused_values, samples + channel * number_of_groups, channel_keys, number_of_groups);
+    }
+
+    // Normalized once per group like simd::MaximumNormalizedWeightedSum
+    for (size_t group = 0; group < number_of_groups; ++group)
+    {
+      fused_values[group] = max_keys[group] != 0.0 ? fused_values[group] * (1.0 / max_keys[group]) : TSample(0);
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<double, tAllocator<double>> max_keys;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
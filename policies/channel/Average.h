@@ -29,7 +29,9 @@
  *
  * \b Average
  *
- * A few words for Average
+ * Average of all samples of the current timestep. Only the running sums
+ * of samples and keys are stored, so memory usage and the cost of
+ * GetSample and GetKey are constant.
  *
  */
 //----------------------------------------------------------------------
@@ -45,7 +47,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
-#include "rrlib/data_fusion/functions.h"
+#include "rrlib/data_fusion/tAccumulator.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -68,53 +70,82 @@ namespace channel
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of Average
-/*! A more detailed description of Average, which
- *  Tobias Foehst hasn't done yet !!
- */
-template <typename TSample>
-class Average : public Base<TSample>
+namespace internal
 {
 
+//! Implementation shared by Average and StaticAverage
+template <typename TSample, typename TBase>
+class Average : public TBase
+{
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  Average()
+    : accumulated_keys(0),
+      number_of_samples(0)
+  {}
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  std::vector<TSample> samples;
-  std::vector<double> keys;
+  tAccumulator<TSample> accumulated_samples;
+  double accumulated_keys;
+  size_t number_of_samples;
 
-  virtual void AddSampleImplementation(const TSample &sample, double key)
+  void AddSampleImplementation(const TSample &sample, double key)
   {
-    this->samples.push_back(sample);
-    this->keys.push_back(key);
+    this->accumulated_samples.Add(sample);
+    this->accumulated_keys += key;
+    this->number_of_samples++;
     this->SetValid(true);
   }
 
-  virtual const TSample GetSampleImplementation() const
+  const TSample GetSampleImplementation() const
   {
-    return FuseValuesUsingAverage<TSample>(this->samples.begin(), this->samples.end());
+    return this->accumulated_samples.Result(1.0 / this->number_of_samples);
   }
 
-  virtual const double GetKeyImplementation() const
+  const double GetKeyImplementation() const
   {
-    return FuseValuesUsingAverage<TSample>(this->keys.begin(), this->keys.end());
+    return this->accumulated_keys / this->number_of_samples;
   }
 
-  virtual void ClearDataImplementation()
+  void ClearDataImplementation()
   {
-    this->samples.clear();
-    this->keys.clear();
+    this->accumulated_samples.Clear();
+    this->accumulated_keys = 0;
+    this->number_of_samples = 0;
     this->SetValid(false);
   }
 
-  virtual void PrepareForNextTimestepImplementation()
+  void PrepareForNextTimestepImplementation()
   {
     this->ClearDataImplementation();
   }
 
 };
 
+}
+
+//! Short description of Average
+/*! A more detailed description of Average, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <typename TSample>
+class Average : public internal::Average<TSample, Base<TSample>>
+{};
+
+//! Statically dispatched variant of Average
+template <typename TSample>
+class StaticAverage : public internal::Average<TSample, StaticBase<StaticAverage<TSample>, TSample>>
+{};
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
@@ -43,6 +43,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/policies/channel/StaticBase.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -70,74 +71,15 @@ namespace channel
  *  Tobias Foehst hasn't done yet !!
  */
 template <typename TSample>
-class Base
+class Base : public StaticBase<Base<TSample>, TSample>
 {
-
-//----------------------------------------------------------------------
-// Public methods and typedefs
-//----------------------------------------------------------------------
-public:
-
-  Base()
-    : valid(0)
-  {}
-
-  inline const bool IsValid() const
-  {
-    return this->valid;
-  }
-
-  void AddSample(const TSample &sample, double key)
-  {
-    this->AddSampleImplementation(sample, key);
-  }
-
-  const TSample GetSample() const
-  {
-    if (!this->valid)
-    {
-      throw std::runtime_error("Trying to get sample from invalid channel");
-    }
-    return this->GetSampleImplementation();
-  }
-
-  const double GetKey() const
-  {
-    if (!this->valid)
-    {
-      throw std::runtime_error("Trying to get key from invalid channel");
-    }
-    return this->GetKeyImplementation();
-  }
-
-  void ClearData()
-  {
-    this->valid = false;
-    this->ClearDataImplementation();
-  }
-
-  void PrepareForNextTimestep()
-  {
-    this->PrepareForNextTimestepImplementation();
-  }
-
-//----------------------------------------------------------------------
-// Protected methods
-//----------------------------------------------------------------------
-protected:
-
-  inline void SetValid(bool valid)
-  {
-    this->valid = valid;
-  }
+  friend class StaticBase<Base<TSample>, TSample>;
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  bool valid;
-
   virtual void AddSampleImplementation(const TSample &sample, double key) = 0;
   virtual const TSample GetSampleImplementation() const = 0;
   virtual const double GetKeyImplementation() const = 0;
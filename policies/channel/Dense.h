@@ -0,0 +1,150 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    Dense.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains Dense
+ *
+ * \b Dense
+ *
+ * Channel policy with the semantics of LastValue whose channels are
+ * stored in a tChannelBank (structure of arrays) instead of a vector of
+ * channel objects.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__channel__Dense_h__
+#define __rrlib__data_fusion__policies__channel__Dense_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tStaticDataFusion.h"
+#include "rrlib/data_fusion/tChannelBank.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace channel
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Reference to one channel of a tChannelBank
+/*! Objects of this class are handed out by the bank and behave like a
+ *  channel policy object. As the fusion classes only read channels after
+ *  checking the validity of all of them, GetSample and GetKey do not
+ *  check validity in order to keep the fusion loops free of branches.
+ */
+template <typename TSample>
+class Dense
+{
+  friend class tChannelBank<TSample>;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  inline const bool IsValid() const
+  {
+    return this->bank->IsValid(this->channel);
+  }
+
+  inline void AddSample(const TSample &sample, double key)
+  {
+    this->bank->Assign(this->channel, sample, key);
+  }
+
+  inline const TSample &GetSample() const
+  {
+    assert(this->IsValid());
+    return this->bank->Sample(this->channel);
+  }
+
+  inline const double GetKey() const
+  {
+    assert(this->IsValid());
+    return this->bank->Key(this->channel);
+  }
+
+  inline void ClearData()
+  {
+    this->bank->SetValid(this->channel, false);
+  }
+
+  inline bool PrepareForNextTimestep()
+  {
+    return false;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tChannelBank<TSample> *bank;
+  size_t channel;
+
+  Dense(tChannelBank<TSample> &bank, size_t channel)
+    : bank(&bank),
+      channel(channel)
+  {}
+
+};
+
+}
+
+//! Channels using the Dense policy are stored in a tChannelBank
+template <typename TSample>
+struct tChannelStorage<TSample, channel::Dense>
+{
+  typedef tChannelBank<TSample> type;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -0,0 +1,164 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    ExponentialAverage.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains ExponentialAverage
+ *
+ * \b ExponentialAverage
+ *
+ * Exponential moving average of the samples and keys of a channel. Each
+ * new sample s changes the average a to a + alpha * (s - a), so the
+ * channel only stores one accumulated sample and key.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__channel__ExponentialAverage_h__
+#define __rrlib__data_fusion__policies__channel__ExponentialAverage_h__
+
+#include "rrlib/data_fusion/policies/channel/Base.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <ratio>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tAccumulator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace channel
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Implementation shared by ExponentialAverage::Policy and ExponentialAverage::StaticPolicy
+template <typename TSample, typename TSmoothingFactor, typename TBase>
+class ExponentialAverage : public TBase
+{
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  ExponentialAverage()
+    : key(0)
+  {}
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tAccumulator<TSample> sample;
+  double key;
+
+  void AddSampleImplementation(const TSample &sample, double key)
+  {
+    const double alpha = static_cast<double>(TSmoothingFactor::num) / TSmoothingFactor::den;
+    if (!this->IsValid())
+    {
+      this->sample.Clear();
+      this->sample.Add(sample);
+      this->key = key;
+      this->SetValid(true);
+      return;
+    }
+    this->sample.Scale(1 - alpha);
+    this->sample.Add(sample, alpha);
+    this->key += alpha * (key - this->key);
+  }
+
+  const TSample GetSampleImplementation() const
+  {
+    return this->sample.Result(1);
+  }
+
+  const double GetKeyImplementation() const
+  {
+    return this->key;
+  }
+
+  void ClearDataImplementation()
+  {}
+
+  void PrepareForNextTimestepImplementation()
+  {}
+
+};
+
+}
+
+//! Channel policies with exponential smoothing of all samples
+/*! TSmoothingFactor is a std::ratio in (0, 1], the weight of a new
+ *  sample, e.g. ExponentialAverage<std::ratio<1, 10>>::Policy. The first
+ *  sample after construction or ClearData initializes the average. The
+ *  average is kept across timesteps.
+ */
+template <typename TSmoothingFactor>
+struct ExponentialAverage
+{
+  static_assert(TSmoothingFactor::num > 0 && TSmoothingFactor::num <= TSmoothingFactor::den, "Smoothing factor must be in (0, 1]");
+
+  template <typename TSample>
+  class Policy : public internal::ExponentialAverage<TSample, TSmoothingFactor, Base<TSample>>
+  {};
+
+  //! Statically dispatched variant of Policy
+  template <typename TSample>
+  class StaticPolicy : public internal::ExponentialAverage<TSample, TSmoothingFactor, StaticBase<StaticPolicy<TSample>, TSample>>
+  {};
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
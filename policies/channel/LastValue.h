@@ -67,14 +67,15 @@ namespace channel
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of LastValue
-/*! A more detailed description of LastValue, which
- *  Tobias Foehst hasn't done yet !!
- */
-template <typename TSample>
-class LastValue : public Base<TSample>
+namespace internal
 {
 
+//! Implementation shared by LastValue and StaticLastValue
+template <typename TSample, typename TBase>
+class LastValue : public TBase
+{
+  friend TBase;
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -83,31 +84,46 @@ private:
   TSample sample;
   double key;
 
-  virtual void AddSampleImplementation(const TSample &sample, double key)
+  void AddSampleImplementation(const TSample &sample, double key)
   {
     this->sample = sample;
     this->key = key;
     this->SetValid(true);
   }
 
-  virtual const TSample GetSampleImplementation() const
+  const TSample GetSampleImplementation() const
   {
     return this->sample;
   }
 
-  virtual const double GetKeyImplementation() const
+  const double GetKeyImplementation() const
   {
     return this->key;
   }
 
-  virtual void ClearDataImplementation()
+  void ClearDataImplementation()
   {}
 
-  virtual void PrepareForNextTimestepImplementation()
+  void PrepareForNextTimestepImplementation()
   {}
 
 };
 
+}
+
+//! Short description of LastValue
+/*! A more detailed description of LastValue, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <typename TSample>
+class LastValue : public internal::LastValue<TSample, Base<TSample>>
+{};
+
+//! Statically dispatched variant of LastValue
+template <typename TSample>
+class StaticLastValue : public internal::LastValue<TSample, StaticBase<StaticLastValue<TSample>, TSample>>
+{};
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
@@ -29,7 +29,8 @@
  *
  * \b Median
  *
- * A few words for Median
+ * Median of all samples and of all keys of the current timestep, both
+ * maintained incrementally in a tRunningMedian.
  *
  */
 //----------------------------------------------------------------------
@@ -45,6 +46,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/tRunningMedian.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -67,53 +69,69 @@ namespace channel
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of Median
-/*! A more detailed description of Median, which
- *  Tobias Foehst hasn't done yet !!
- */
-template <typename TSample>
-class Median : public Base<TSample>
+namespace internal
 {
 
+//! Implementation shared by Median and StaticMedian
+template <typename TSample, typename TBase>
+class Median : public TBase
+{
+  friend TBase;
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  std::vector<TSample> samples;
-  std::vector<double> keys;
+  tRunningMedian<TSample> samples;
+  tRunningMedian<double> keys;
 
-  virtual void AddSampleImplementation(const TSample &sample, double key)
+  void AddSampleImplementation(const TSample &sample, double key)
   {
-    this->samples.push_back(sample);
-    this->keys.push_back(key);
+    this->samples.Add(sample);
+    this->keys.Add(key);
     this->SetValid(true);
   }
 
-  virtual const TSample GetSampleImplementation() const
+  const TSample GetSampleImplementation() const
   {
-    return FuseValuesUsingMedianVoter<TSample>(this->samples.begin(), this->samples.end());
+    return this->samples.Median();
   }
 
-  virtual const double GetKeyImplementation() const
+  const double GetKeyImplementation() const
   {
-    return FuseValuesUsingMedianVoter<TSample>(this->keys.begin(), this->keys.end());
+    return this->keys.Median();
   }
 
-  virtual void ClearDataImplementation()
+  void ClearDataImplementation()
   {
-    this->samples.clear();
-    this->keys.clear();
+    this->samples.Clear();
+    this->keys.Clear();
     this->SetValid(false);
   }
 
-  virtual void PrepareForNextTimestepImplementation()
+  void PrepareForNextTimestepImplementation()
   {
     this->ClearDataImplementation();
   }
 
 };
 
+}
+
+//! Short description of Median
+/*! A more detailed description of Median, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <typename TSample>
+class Median : public internal::Median<TSample, Base<TSample>>
+{};
+
+//! Statically dispatched variant of Median
+template <typename TSample>
+class StaticMedian : public internal::Median<TSample, StaticBase<StaticMedian<TSample>, TSample>>
+{};
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
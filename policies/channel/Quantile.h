@@ -0,0 +1,174 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    Quantile.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains Quantile and ApproximateMedian
+ *
+ * \b Quantile
+ *
+ * Estimate of a quantile of all samples and of all keys of the current
+ * timestep, using a tQuantileEstimator. In contrast to Median, memory
+ * and cost per sample do not depend on the number of samples.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__channel__Quantile_h__
+#define __rrlib__data_fusion__policies__channel__Quantile_h__
+
+#include "rrlib/data_fusion/policies/channel/Base.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <ratio>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tQuantileEstimator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace channel
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Implementation shared by the Quantile and ApproximateMedian policies
+template <typename TSample, typename TQuantile, typename TBase>
+class Quantile : public TBase
+{
+  friend TBase;
+
+  static_assert(std::is_arithmetic<TSample>::value, "Quantile estimation is only available for arithmetic sample types");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  Quantile()
+    : samples(static_cast<double>(TQuantile::num) / TQuantile::den),
+      keys(static_cast<double>(TQuantile::num) / TQuantile::den)
+  {}
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tQuantileEstimator samples;
+  tQuantileEstimator keys;
+
+  void AddSampleImplementation(const TSample &sample, double key)
+  {
+    this->samples.Add(sample);
+    this->keys.Add(key);
+    this->SetValid(true);
+  }
+
+  const TSample GetSampleImplementation() const
+  {
+    return static_cast<TSample>(this->samples.Quantile());
+  }
+
+  const double GetKeyImplementation() const
+  {
+    return this->keys.Quantile();
+  }
+
+  void ClearDataImplementation()
+  {
+    this->samples.Clear();
+    this->keys.Clear();
+    this->SetValid(false);
+  }
+
+  void PrepareForNextTimestepImplementation()
+  {
+    this->ClearDataImplementation();
+  }
+
+};
+
+}
+
+//! Channel policies estimating the quantile given as std::ratio
+/*! Channel policies only take the sample type as template parameter, so
+ *  they are nested here, e.g. Quantile<std::ratio<9, 10>>::Policy for the
+ *  90% quantile.
+ */
+template <typename TQuantile>
+struct Quantile
+{
+  static_assert(TQuantile::num >= 0 && TQuantile::num <= TQuantile::den, "Quantile must be in [0, 1]");
+
+  template <typename TSample>
+  class Policy : public internal::Quantile<TSample, TQuantile, Base<TSample>>
+  {};
+
+  //! Statically dispatched variant of Policy
+  template <typename TSample>
+  class StaticPolicy : public internal::Quantile<TSample, TQuantile, StaticBase<StaticPolicy<TSample>, TSample>>
+  {};
+};
+
+//! Constant-space approximation of Median
+template <typename TSample>
+class ApproximateMedian : public internal::Quantile<TSample, std::ratio<1, 2>, Base<TSample>>
+{};
+
+//! Statically dispatched variant of ApproximateMedian
+template <typename TSample>
+class StaticApproximateMedian : public internal::Quantile<TSample, std::ratio<1, 2>, StaticBase<StaticApproximateMedian<TSample>, TSample>>
+{};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
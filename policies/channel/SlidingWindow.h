@@ -0,0 +1,420 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    SlidingWindow.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains SlidingWindow and SlidingTimeWindow
+ *
+ * \b SlidingWindow
+ *
+ * Channel policies that fuse the most recent samples of a channel,
+ * independent of timestep boundaries. The samples are kept in a ring
+ * buffer with fixed capacity that is part of the channel object, so no
+ * memory is allocated after construction.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__channel__SlidingWindow_h__
+#define __rrlib__data_fusion__policies__channel__SlidingWindow_h__
+
+#include "rrlib/data_fusion/policies/channel/Base.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <ratio>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tAccumulator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace channel
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Mean of the values in a window, maintained as running sum
+template <typename TValue, size_t Tcapacity>
+class tWindowAverage
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  //! The running sum accumulates rounding errors and is rebuilt from time to time
+  enum { cRENORMALIZE = true };
+
+  tWindowAverage()
+    : count(0)
+  {}
+
+  inline void Add(const TValue &value)
+  {
+    this->accumulator.Add(value);
+    this->count++;
+  }
+
+  inline void Remove(const TValue &value)
+  {
+    this->accumulator.Remove(value);
+    this->count--;
+  }
+
+  inline const TValue Result() const
+  {
+    return this->accumulator.Result(1.0 / this->count);
+  }
+
+  inline void Clear()
+  {
+    this->accumulator.Clear();
+    this->count = 0;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tAccumulator<TValue> accumulator;
+  size_t count;
+
+};
+
+//! Median of the values in a window, which are kept sorted
+/*! Floating point NaN is sorted after all other values, so it does not
+ *  break the order that Add and Remove rely on.
+ */
+template <typename TValue, size_t Tcapacity>
+class tWindowMedian
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  enum { cRENORMALIZE = false };
+
+  tWindowMedian()
+    : count(0)
+  {}
+
+  inline void Add(const TValue &value)
+  {
+    TValue *end = this->sorted.data() + this->count;
+    TValue *position = std::upper_bound(this->sorted.data(), end, value, tLess());
+    std::copy_backward(position, end, end + 1);
+    *position = value;
+    this->count++;
+  }
+
+  inline void Remove(const TValue &value)
+  {
+    TValue *end = this->sorted.data() + this->count;
+    TValue *position = std::lower_bound(this->sorted.data(), end, value, tLess());
+    std::copy(position + 1, end, position);
+    this->count--;
+  }
+
+  inline const TValue Result() const
+  {
+    return this->sorted[this->count / 2];
+  }
+
+  inline void Clear()
+  {
+    this->count = 0;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tLess
+  {
+    inline bool operator()(const TValue &a, const TValue &b) const
+    {
+      return Less(a, b, std::is_floating_point<TValue>());
+    }
+
+    static inline bool Less(const TValue &a, const TValue &b, std::true_type)
+    {
+      return !std::isnan(a) && (std::isnan(b) || a < b);
+    }
+
+    static inline bool Less(const TValue &a, const TValue &b, std::false_type)
+    {
+      return a < b;
+    }
+  };
+
+  std::array<TValue, Tcapacity> sorted;
+  size_t count;
+
+};
+
+/*! Implementation shared by the sliding window policies. TStatistic is
+ *  tWindowAverage or tWindowMedian. TSpan is void for windows limited by
+ *  the number of samples only, or a std::ratio giving the time span in
+ *  seconds after which samples are dropped.
+ */
+template <
+typename TSample,
+         size_t Tcapacity,
+         template <typename, size_t> class TStatistic,
+         typename TSpan,
+         typename TBase
+         >
+class SlidingWindow : public TBase
+{
+  friend TBase;
+
+  static_assert(Tcapacity > 0, "Sliding window needs a capacity greater than zero");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  SlidingWindow()
+    : first(0),
+      size(0),
+      number_of_removals(0)
+  {}
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  typedef std::chrono::steady_clock tClock;
+  typedef std::integral_constant < bool, !std::is_void<TSpan>::value > tIsTimeWindow;
+
+  struct tEntry
+  {
+    TSample sample;
+    double key;
+    tClock::time_point timestamp;
+  };
+
+  std::array<tEntry, Tcapacity> entries;
+  size_t first;
+  size_t size;
+  size_t number_of_removals;
+  TStatistic<TSample, Tcapacity> samples;
+  TStatistic<double, Tcapacity> keys;
+
+  void AddSampleImplementation(const TSample &sample, double key)
+  {
+    if (this->size == Tcapacity)
+    {
+      this->RemoveOldest();
+    }
+    tEntry &entry = this->entries[(this->first + this->size) % Tcapacity];
+    entry.sample = sample;
+    entry.key = key;
+    entry.timestamp = Now(tIsTimeWindow());
+    this->size++;
+    this->samples.Add(sample);
+    this->keys.Add(key);
+    this->SetValid(true);
+    this->DropExpired(entry.timestamp, tIsTimeWindow());
+  }
+
+  const TSample GetSampleImplementation() const
+  {
+    return this->samples.Result();
+  }
+
+  const double GetKeyImplementation() const
+  {
+    return this->keys.Result();
+  }
+
+  void ClearDataImplementation()
+  {
+    this->first = 0;
+    this->size = 0;
+    this->number_of_removals = 0;
+    this->samples.Clear();
+    this->keys.Clear();
+    this->SetValid(false);
+  }
+
+  void PrepareForNextTimestepImplementation()
+  {
+    if (this->DropExpired(Now(tIsTimeWindow()), tIsTimeWindow()))
+    {
+      this->SetChanged();
+    }
+  }
+
+  static inline tClock::time_point Now(std::true_type)
+  {
+    return tClock::now();
+  }
+
+  static inline tClock::time_point Now(std::false_type)
+  {
+    return tClock::time_point();
+  }
+
+  //! Returns whether samples were dropped. The most recent sample is always kept, so a valid channel stays valid.
+  bool DropExpired(tClock::time_point now, std::true_type)
+  {
+    const tClock::duration span = std::chrono::duration_cast<tClock::duration>(std::chrono::duration<double, TSpan>(1));
+    size_t previous_size = this->size;
+    while (this->size > 1 && now - this->entries[this->first].timestamp > span)
+    {
+      this->RemoveOldest();
+    }
+    return this->size != previous_size;
+  }
+
+  inline bool DropExpired(tClock::time_point, std::false_type)
+  {
+    return false;
+  }
+
+  void RemoveOldest()
+  {
+    const tEntry &entry = this->entries[this->first];
+    this->samples.Remove(entry.sample);
+    this->keys.Remove(entry.key);
+    this->first = (this->first + 1) % Tcapacity;
+    this->size--;
+    if (TStatistic<TSample, Tcapacity>::cRENORMALIZE && ++this->number_of_removals >= Tcapacity)
+    {
+      this->samples.Clear();
+      this->keys.Clear();
+      for (size_t i = 0; i < this->size; ++i)
+      {
+        const tEntry &remaining = this->entries[(this->first + i) % Tcapacity];
+        this->samples.Add(remaining.sample);
+        this->keys.Add(remaining.key);
+      }
+      this->number_of_removals = 0;
+    }
+  }
+
+};
+
+}
+
+//! Policies fusing the last Tcapacity samples of a channel
+/*! The window mean is available in constant time, the window median in
+ *  time linear in Tcapacity for adding a sample (the window is kept
+ *  sorted in place) and constant time for reading.
+ *
+ *  Usage: tAverage<double, channel::SlidingWindow<10>::Median>
+ */
+template <size_t Tcapacity>
+struct SlidingWindow
+{
+  template <typename TSample>
+  class Average : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowAverage, void, Base<TSample>>
+  {};
+
+  template <typename TSample>
+  class StaticAverage : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowAverage, void, StaticBase<StaticAverage<TSample>, TSample>>
+  {};
+
+  template <typename TSample>
+  class Median : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowMedian, void, Base<TSample>>
+  {};
+
+  template <typename TSample>
+  class StaticMedian : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowMedian, void, StaticBase<StaticMedian<TSample>, TSample>>
+  {};
+};
+
+//! Like SlidingWindow, but samples older than TSpan seconds (a std::ratio) are dropped
+/*! Tcapacity bounds the number of samples within the time span. The
+ *  most recent sample is never dropped.
+ *
+ *  Expired samples are dropped when a sample is added and when the fusion
+ *  object enters the next timestep, so the window only moves at these
+ *  points and reading the fused value never changes it.
+ *
+ *  Usage: tAverage<double, channel::SlidingTimeWindow<100, std::ratio<1, 10>>::Average>
+ *  (at most 100 samples of the last 100 ms)
+ */
+template <size_t Tcapacity, typename TSpan>
+struct SlidingTimeWindow
+{
+  template <typename TSample>
+  class Average : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowAverage, TSpan, Base<TSample>>
+  {};
+
+  template <typename TSample>
+  class StaticAverage : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowAverage, TSpan, StaticBase<StaticAverage<TSample>, TSample>>
+  {};
+
+  template <typename TSample>
+  class Median : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowMedian, TSpan, Base<TSample>>
+  {};
+
+  template <typename TSample>
+  class StaticMedian : public internal::SlidingWindow<TSample, Tcapacity, internal::tWindowMedian, TSpan, StaticBase<StaticMedian<TSample>, TSample>>
+  {};
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
@@ -0,0 +1,215 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    StaticBase.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains StaticBase
+ *
+ * \b StaticBase
+ *
+ * Statically dispatched (CRTP) counterpart of Base. Channel policies
+ * derived from StaticBase provide the same interface but their
+ * implementation methods are resolved at compile time.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__policies__channel__StaticBase_h__
+#define __rrlib__data_fusion__policies__channel__StaticBase_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <stdexcept>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tFusionResult.h"
+#include "rrlib/data_fusion/tracing.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+namespace channel
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Statically dispatched base class for channel policies
+/*! TChannel is the most derived channel class. It has to provide the
+ *  methods AddSampleImplementation, GetSampleImplementation,
+ *  GetKeyImplementation, ClearDataImplementation and
+ *  PrepareForNextTimestepImplementation with the same signatures as the
+ *  pure virtual methods of Base. They may be private if this class is
+ *  declared as friend.
+ *
+ *  Policies whose sample or key changes in
+ *  PrepareForNextTimestepImplementation call SetChanged, so the fusion
+ *  object does not keep using its previous fused value.
+ *
+ *  The policies in this directory are implemented once in namespace
+ *  internal, parameterized with their base class. Their implementation
+ *  methods are declared without virtual, so they only override when the
+ *  base is Base<TSample>.
+ */
+template <typename TChannel, typename TSample>
+class StaticBase
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  StaticBase()
+    : valid(0),
+      changed(false)
+  {}
+
+  inline const bool IsValid() const
+  {
+    return this->valid;
+  }
+
+  void AddSample(const TSample &sample, double key)
+  {
+    RRLIB_DATA_FUSION_TRACE_CHANNEL_POLICY("AddSample");
+    this->Channel().AddSampleImplementation(sample, key);
+  }
+
+  const TSample GetSample() const
+  {
+    if (RRLIB_DATA_FUSION_UNLIKELY(!this->valid))
+    {
+      ThrowInvalidChannel("Trying to get sample from invalid channel");
+    }
+    return this->Channel().GetSampleImplementation();
+  }
+
+  const double GetKey() const
+  {
+    if (RRLIB_DATA_FUSION_UNLIKELY(!this->valid))
+    {
+      ThrowInvalidChannel("Trying to get key from invalid channel");
+    }
+    return this->Channel().GetKeyImplementation();
+  }
+
+  //! Noexcept variant of GetSample that yields INVALID_CHANNEL instead of throwing
+  tFusionResult<TSample> TryGetSample() const noexcept
+  {
+    if (RRLIB_DATA_FUSION_UNLIKELY(!this->valid))
+    {
+      return tFusionStatus::INVALID_CHANNEL;
+    }
+    return this->Channel().GetSampleImplementation();
+  }
+
+  tFusionResult<double> TryGetKey() const noexcept
+  {
+    if (RRLIB_DATA_FUSION_UNLIKELY(!this->valid))
+    {
+      return tFusionStatus::INVALID_CHANNEL;
+    }
+    return this->Channel().GetKeyImplementation();
+  }
+
+  void ClearData()
+  {
+    RRLIB_DATA_FUSION_TRACE_CHANNEL_POLICY("ClearData");
+    this->valid = false;
+    this->Channel().ClearDataImplementation();
+  }
+
+  //! Returns whether the sample or key of the channel changed
+  bool PrepareForNextTimestep()
+  {
+    RRLIB_DATA_FUSION_TRACE_CHANNEL_POLICY("PrepareForNextTimestep");
+    this->changed = false;
+    this->Channel().PrepareForNextTimestepImplementation();
+    return this->changed;
+  }
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  inline void SetValid(bool valid)
+  {
+    this->valid = valid;
+  }
+
+  inline void SetChanged()
+  {
+    this->changed = true;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  bool valid;
+  bool changed;
+
+  [[noreturn]] static RRLIB_DATA_FUSION_COLD void ThrowInvalidChannel(const char *message)
+  {
+    throw std::runtime_error(message);
+  }
+
+  inline TChannel &Channel()
+  {
+    return *static_cast<TChannel *>(this);
+  }
+
+  inline const TChannel &Channel() const
+  {
+    return *static_cast<const TChannel *>(this);
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
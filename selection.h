@@ -0,0 +1,313 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    selection.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   In-place selection of the n-th element of a range
+ *
+ * Used by the median voters. Both algorithms work in place without
+ * allocating memory. Introselect (std::nth_element) is fastest on
+ * average, median of medians guarantees linear time in the worst case.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__selection_h__
+#define __rrlib__data_fusion__selection_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+enum class tSelectionAlgorithm
+{
+  INTROSELECT,        //!< std::nth_element, fastest on average
+  MEDIAN_OF_MEDIANS   //!< Linear time in the worst case
+};
+
+namespace selection
+{
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+template <typename TIterator, typename TCompare>
+void InsertionSort(TIterator first, TIterator last, TCompare compare)
+{
+  for (TIterator it = first; it != last; ++it)
+  {
+    for (TIterator current = it; current != first && compare(*current, *std::prev(current)); --current)
+    {
+      std::iter_swap(current, std::prev(current));
+    }
+  }
+}
+
+template <typename TIterator, typename TCompare>
+TIterator PivotOfMedians(TIterator first, TIterator last, TCompare compare);
+
+//! Compare-exchange that keeps equivalent elements
+template <typename TValue, typename TCompare>
+inline void CompareExchange(TValue &a, TValue &b, TCompare compare)
+{
+  const bool swap = compare(b, a);
+  const TValue low = swap ? b : a;
+  const TValue high = swap ? a : b;
+  a = low;
+  b = high;
+}
+
+//! Branch-free compare-exchange of arithmetic values using min and max instructions
+template <typename TValue>
+inline typename std::enable_if<std::is_arithmetic<TValue>::value>::type CompareExchange(TValue &a, TValue &b, std::less<TValue>)
+{
+  const TValue low = std::min(a, b);
+  b = std::max(a, b);
+  a = low;
+}
+
+/*! Selection networks that move the median of 3, 5, 7 or 9 values to
+ *  the middle position (networks by Paeth and Devillard). They always
+ *  perform the same comparisons, independent of the data.
+ */
+template <size_t Tsize>
+struct tMedianNetwork;
+
+template <>
+struct tMedianNetwork<3>
+{
+  template <typename TIterator, typename TCompare>
+  static inline void Apply(TIterator p, TCompare compare)
+  {
+    CompareExchange(p[0], p[1], compare);
+    CompareExchange(p[1], p[2], compare);
+    CompareExchange(p[0], p[1], compare);
+  }
+};
+
+template <>
+struct tMedianNetwork<5>
+{
+  template <typename TIterator, typename TCompare>
+  static inline void Apply(TIterator p, TCompare compare)
+  {
+    CompareExchange(p[0], p[1], compare);
+    CompareExchange(p[3], p[4], compare);
+    CompareExchange(p[0], p[3], compare);
+    CompareExchange(p[1], p[4], compare);
+    CompareExchange(p[1], p[2], compare);
+    CompareExchange(p[2], p[3], compare);
+    CompareExchange(p[1], p[2], compare);
+  }
+};
+
+template <>
+struct tMedianNetwork<7>
+{
+  template <typename TIterator, typename TCompare>
+  static inline void Apply(TIterator p, TCompare compare)
+  {
+    CompareExchange(p[0], p[5], compare);
+    CompareExchange(p[0], p[3], compare);
+    CompareExchange(p[1], p[6], compare);
+    CompareExchange(p[2], p[4], compare);
+    CompareExchange(p[0], p[1], compare);
+    CompareExchange(p[3], p[5], compare);
+    CompareExchange(p[2], p[6], compare);
+    CompareExchange(p[2], p[3], compare);
+    CompareExchange(p[3], p[6], compare);
+    CompareExchange(p[4], p[5], compare);
+    CompareExchange(p[1], p[4], compare);
+    CompareExchange(p[1], p[3], compare);
+    CompareExchange(p[3], p[4], compare);
+  }
+};
+
+template <>
+struct tMedianNetwork<9>
+{
+  template <typename TIterator, typename TCompare>
+  static inline void Apply(TIterator p, TCompare compare)
+  {
+    CompareExchange(p[1], p[2], compare);
+    CompareExchange(p[4], p[5], compare);
+    CompareExchange(p[7], p[8], compare);
+    CompareExchange(p[0], p[1], compare);
+    CompareExchange(p[3], p[4], compare);
+    CompareExchange(p[6], p[7], compare);
+    CompareExchange(p[1], p[2], compare);
+    CompareExchange(p[4], p[5], compare);
+    CompareExchange(p[7], p[8], compare);
+    CompareExchange(p[0], p[3], compare);
+    CompareExchange(p[5], p[8], compare);
+    CompareExchange(p[4], p[7], compare);
+    CompareExchange(p[3], p[6], compare);
+    CompareExchange(p[1], p[4], compare);
+    CompareExchange(p[2], p[5], compare);
+    CompareExchange(p[4], p[7], compare);
+    CompareExchange(p[4], p[2], compare);
+    CompareExchange(p[6], p[4], compare);
+    CompareExchange(p[4], p[2], compare);
+  }
+};
+
+}
+
+//! Rearranges [first, last) like std::nth_element in guaranteed linear time
+template <typename TIterator, typename TCompare>
+void MedianOfMedians(TIterator first, TIterator nth, TIterator last, TCompare compare)
+{
+  typedef typename std::iterator_traits<TIterator>::value_type tValue;
+
+  while (std::distance(first, last) > 5)
+  {
+    const tValue pivot = *internal::PivotOfMedians(first, last, compare);
+    TIterator lower = std::partition(first, last, [&](const tValue & value)
+    {
+      return compare(value, pivot);
+    });
+    TIterator upper = std::partition(lower, last, [&](const tValue & value)
+    {
+      return !compare(pivot, value);
+    });
+    if (nth < lower)
+    {
+      last = lower;
+    }
+    else if (nth >= upper)
+    {
+      first = upper;
+    }
+    else
+    {
+      return;
+    }
+  }
+  internal::InsertionSort(first, last, compare);
+}
+
+//! Rearranges [first, last) so that nth holds the element that would be there if the range was sorted
+template <typename TIterator, typename TCompare>
+inline void Select(TIterator first, TIterator nth, TIterator last, TCompare compare, tSelectionAlgorithm algorithm = tSelectionAlgorithm::INTROSELECT)
+{
+  if (algorithm == tSelectionAlgorithm::MEDIAN_OF_MEDIANS)
+  {
+    MedianOfMedians(first, nth, last, compare);
+  }
+  else
+  {
+    std::nth_element(first, nth, last, compare);
+  }
+}
+
+/*! Moves the median of [first, last) to the middle position and returns
+ *  an iterator to it. Ranges of 3, 5, 7 or 9 elements use a fixed
+ *  selection network with data-independent latency, all other sizes the
+ *  given selection algorithm. For fusion objects with a fixed number of
+ *  channels the size is known at compile time and only the network
+ *  remains.
+ */
+template <typename TIterator, typename TCompare>
+inline TIterator SelectMedian(TIterator first, TIterator last, TCompare compare, tSelectionAlgorithm algorithm = tSelectionAlgorithm::INTROSELECT)
+{
+  const size_t size = std::distance(first, last);
+  switch (size)
+  {
+  case 3:
+    internal::tMedianNetwork<3>::Apply(first, compare);
+    break;
+  case 5:
+    internal::tMedianNetwork<5>::Apply(first, compare);
+    break;
+  case 7:
+    internal::tMedianNetwork<7>::Apply(first, compare);
+    break;
+  case 9:
+    internal::tMedianNetwork<9>::Apply(first, compare);
+    break;
+  default:
+    Select(first, first + size / 2, last, compare, algorithm);
+  }
+  return first + size / 2;
+}
+
+namespace internal
+{
+
+/*! Moves the medians of groups of five to the front of the range and
+ *  returns an iterator to the median of these medians.
+ */
+template <typename TIterator, typename TCompare>
+TIterator PivotOfMedians(TIterator first, TIterator last, TCompare compare)
+{
+  TIterator medians_end = first;
+  for (TIterator group = first; group != last;)
+  {
+    TIterator group_end = group + std::min<typename std::iterator_traits<TIterator>::difference_type>(5, std::distance(group, last));
+    InsertionSort(group, group_end, compare);
+    std::iter_swap(medians_end++, group + std::distance(group, group_end) / 2);
+    group = group_end;
+  }
+  TIterator pivot = first + std::distance(first, medians_end) / 2;
+  MedianOfMedians(first, pivot, medians_end, compare);
+  return pivot;
+}
+
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
@@ -0,0 +1,1012 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    simd.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   SIMD kernels for contiguous arrays of samples and keys
+ *
+ * Sums, weighted sums and maxima of double and float arrays. On x86 the
+ * widest available instruction set (AVX-512, AVX2 or SSE2) is selected
+ * once at runtime, elsewhere a scalar implementation is used. All sums
+ * are accumulated in double precision.
+ *
+ * The fusers use these kernels for channel::Dense channels of double or
+ * float samples. As the kernels add in a different order than a simple
+ * loop, results may differ from the other channel policies in the last
+ * bits.
+ *
+ * The element-wise kernels (AddTo, MultiplyAddTo, AddAbsoluteTo,
+ * MaximumTo and SelectMaximumKey) update one array from others of the
+ * same length. The batch strategies of tBatchedDataFusion call them once
+ * per channel, with the groups in the SIMD lanes. They compute every
+ * element like the scalar loop, except that MultiplyAddTo may round only
+ * once where the instruction set fuses multiplication and addition.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__simd_h__
+#define __rrlib__data_fusion__simd_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <type_traits>
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __rrlib__data_fusion__simd__x86__
+#include <immintrin.h>
+#endif
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+template <typename TSample>
+class tChannelBank;
+
+namespace simd
+{
+
+//! Whether the fusers use the SIMD kernels for channels stored in TChannels
+template <typename TChannels>
+struct tHasKernels : std::false_type
+{};
+
+template <>
+struct tHasKernels<tChannelBank<double>> : std::true_type
+{};
+
+template <>
+struct tHasKernels<tChannelBank<float>> : std::true_type
+{};
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Scalar kernels
+//----------------------------------------------------------------------
+namespace scalar
+{
+
+template <typename T>
+inline double Sum(const T *values, size_t number_of_values)
+{
+  double result = 0;
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+template <typename T>
+inline double WeightedSum(const T *samples, const double *keys, size_t number_of_values)
+{
+  double result = 0;
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+inline double Maximum(const double *values, size_t number_of_values)
+{
+  double result = -std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    result = std::max(result, values[i]);
+  }
+  return result;
+}
+
+inline size_t ArgMax(const double *values, size_t number_of_values)
+{
+  size_t result = 0;
+  for (size_t i = 1; i < number_of_values; ++i)
+  {
+    if (values[i] > values[result])
+    {
+      result = i;
+    }
+  }
+  return result;
+}
+
+template <typename TSum, typename TValue>
+inline void AddTo(TSum *sums, const TValue *values, size_t number_of_values)
+{
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    sums[i] += values[i];
+  }
+}
+
+template <typename TSum, typename TSample>
+inline void MultiplyAddTo(TSum *sums, const TSample *samples, const double *keys, size_t number_of_values)
+{
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    sums[i] += samples[i] * keys[i];
+  }
+}
+
+inline void AddAbsoluteTo(double *sums, const double *values, size_t number_of_values)
+{
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    sums[i] += std::fabs(values[i]);
+  }
+}
+
+inline void MaximumTo(double *maxima, const double *values, size_t number_of_values)
+{
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    maxima[i] = std::max(maxima[i], values[i]);
+  }
+}
+
+template <typename TSample>
+inline void SelectMaximumKey(double *maximum_keys, TSample *selected, const double *keys, const TSample *samples, size_t number_of_values)
+{
+  for (size_t i = 0; i < number_of_values; ++i)
+  {
+    bool greater = keys[i] > maximum_keys[i];
+    maximum_keys[i] = greater ? keys[i] : maximum_keys[i];
+    selected[i] = greater ? samples[i] : selected[i];
+  }
+}
+
+}
+
+#ifdef __rrlib__data_fusion__simd__x86__
+
+//----------------------------------------------------------------------
+// SSE2 kernels
+//----------------------------------------------------------------------
+namespace sse2
+{
+
+__attribute__((target("sse2")))
+inline double HorizontalSum(__m128d value)
+{
+  return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+}
+
+__attribute__((target("sse2")))
+inline double Sum(const double *values, size_t number_of_values)
+{
+  __m128d sum_0 = _mm_setzero_pd();
+  __m128d sum_1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    sum_0 = _mm_add_pd(sum_0, _mm_loadu_pd(values + i));
+    sum_1 = _mm_add_pd(sum_1, _mm_loadu_pd(values + i + 2));
+  }
+  double result = HorizontalSum(_mm_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+__attribute__((target("sse2")))
+inline double Sum(const float *values, size_t number_of_values)
+{
+  __m128d sum_0 = _mm_setzero_pd();
+  __m128d sum_1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    __m128 value = _mm_loadu_ps(values + i);
+    sum_0 = _mm_add_pd(sum_0, _mm_cvtps_pd(value));
+    sum_1 = _mm_add_pd(sum_1, _mm_cvtps_pd(_mm_movehl_ps(value, value)));
+  }
+  double result = HorizontalSum(_mm_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+__attribute__((target("sse2")))
+inline double WeightedSum(const double *samples, const double *keys, size_t number_of_values)
+{
+  __m128d sum_0 = _mm_setzero_pd();
+  __m128d sum_1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    sum_0 = _mm_add_pd(sum_0, _mm_mul_pd(_mm_loadu_pd(samples + i), _mm_loadu_pd(keys + i)));
+    sum_1 = _mm_add_pd(sum_1, _mm_mul_pd(_mm_loadu_pd(samples + i + 2), _mm_loadu_pd(keys + i + 2)));
+  }
+  double result = HorizontalSum(_mm_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+__attribute__((target("sse2")))
+inline double WeightedSum(const float *samples, const double *keys, size_t number_of_values)
+{
+  __m128d sum_0 = _mm_setzero_pd();
+  __m128d sum_1 = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    __m128 sample = _mm_loadu_ps(samples + i);
+    sum_0 = _mm_add_pd(sum_0, _mm_mul_pd(_mm_cvtps_pd(sample), _mm_loadu_pd(keys + i)));
+    sum_1 = _mm_add_pd(sum_1, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(sample, sample)), _mm_loadu_pd(keys + i + 2)));
+  }
+  double result = HorizontalSum(_mm_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+__attribute__((target("sse2")))
+inline double Maximum(const double *values, size_t number_of_values)
+{
+  __m128d maximum = _mm_set1_pd(-std::numeric_limits<double>::infinity());
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    maximum = _mm_max_pd(maximum, _mm_loadu_pd(values + i));
+  }
+  double result = _mm_cvtsd_f64(_mm_max_sd(maximum, _mm_unpackhi_pd(maximum, maximum)));
+  for (; i < number_of_values; ++i)
+  {
+    result = std::max(result, values[i]);
+  }
+  return result;
+}
+
+//! MAXPD returns its second operand if one is NaN, so NaN values never become the maximum
+__attribute__((target("sse2")))
+inline size_t ArgMax(const double *values, size_t number_of_values)
+{
+  if (number_of_values == 0 || values[0] != values[0])
+  {
+    return 0;
+  }
+  __m128d maximum = _mm_set1_pd(values[0]);
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    maximum = _mm_max_pd(_mm_loadu_pd(values + i), maximum);
+  }
+  double result = _mm_cvtsd_f64(_mm_max_sd(maximum, _mm_unpackhi_pd(maximum, maximum)));
+  for (; i < number_of_values; ++i)
+  {
+    result = values[i] > result ? values[i] : result;
+  }
+  __m128d target = _mm_set1_pd(result);
+  for (i = 0; i + 2 <= number_of_values; i += 2)
+  {
+    int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(values + i), target));
+    if (mask)
+    {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  while (values[i] != result)
+  {
+    ++i;
+  }
+  return i;
+}
+
+__attribute__((target("sse2")))
+inline void AddTo(double *sums, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    _mm_storeu_pd(sums + i, _mm_add_pd(_mm_loadu_pd(sums + i), _mm_loadu_pd(values + i)));
+  }
+  scalar::AddTo(sums + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("sse2")))
+inline void MultiplyAddTo(double *sums, const double *samples, const double *keys, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    _mm_storeu_pd(sums + i, _mm_add_pd(_mm_loadu_pd(sums + i), _mm_mul_pd(_mm_loadu_pd(samples + i), _mm_loadu_pd(keys + i))));
+  }
+  scalar::MultiplyAddTo(sums + i, samples + i, keys + i, number_of_values - i);
+}
+
+__attribute__((target("sse2")))
+inline void AddAbsoluteTo(double *sums, const double *values, size_t number_of_values)
+{
+  const __m128d sign = _mm_set1_pd(-0.0);
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    _mm_storeu_pd(sums + i, _mm_add_pd(_mm_loadu_pd(sums + i), _mm_andnot_pd(sign, _mm_loadu_pd(values + i))));
+  }
+  scalar::AddAbsoluteTo(sums + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("sse2")))
+inline void MaximumTo(double *maxima, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    _mm_storeu_pd(maxima + i, _mm_max_pd(_mm_loadu_pd(values + i), _mm_loadu_pd(maxima + i)));
+  }
+  scalar::MaximumTo(maxima + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("sse2")))
+inline void SelectMaximumKey(double *maximum_keys, double *selected, const double *keys, const double *samples, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 2 <= number_of_values; i += 2)
+  {
+    __m128d key = _mm_loadu_pd(keys + i);
+    __m128d maximum_key = _mm_loadu_pd(maximum_keys + i);
+    __m128d greater = _mm_cmpgt_pd(key, maximum_key);
+    _mm_storeu_pd(maximum_keys + i, _mm_or_pd(_mm_and_pd(greater, key), _mm_andnot_pd(greater, maximum_key)));
+    _mm_storeu_pd(selected + i, _mm_or_pd(_mm_and_pd(greater, _mm_loadu_pd(samples + i)), _mm_andnot_pd(greater, _mm_loadu_pd(selected + i))));
+  }
+  scalar::SelectMaximumKey(maximum_keys + i, selected + i, keys + i, samples + i, number_of_values - i);
+}
+
+}
+
+//----------------------------------------------------------------------
+// AVX2 kernels
+//----------------------------------------------------------------------
+namespace avx2
+{
+
+__attribute__((target("avx2")))
+inline double HorizontalSum(__m256d value)
+{
+  __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+__attribute__((target("avx2")))
+inline double Sum(const double *values, size_t number_of_values)
+{
+  __m256d sum_0 = _mm256_setzero_pd();
+  __m256d sum_1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum_0 = _mm256_add_pd(sum_0, _mm256_loadu_pd(values + i));
+    sum_1 = _mm256_add_pd(sum_1, _mm256_loadu_pd(values + i + 4));
+  }
+  double result = HorizontalSum(_mm256_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx2")))
+inline double Sum(const float *values, size_t number_of_values)
+{
+  __m256d sum_0 = _mm256_setzero_pd();
+  __m256d sum_1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum_0 = _mm256_add_pd(sum_0, _mm256_cvtps_pd(_mm_loadu_ps(values + i)));
+    sum_1 = _mm256_add_pd(sum_1, _mm256_cvtps_pd(_mm_loadu_ps(values + i + 4)));
+  }
+  double result = HorizontalSum(_mm256_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx2")))
+inline double WeightedSum(const double *samples, const double *keys, size_t number_of_values)
+{
+  __m256d sum_0 = _mm256_setzero_pd();
+  __m256d sum_1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum_0 = _mm256_add_pd(sum_0, _mm256_mul_pd(_mm256_loadu_pd(samples + i), _mm256_loadu_pd(keys + i)));
+    sum_1 = _mm256_add_pd(sum_1, _mm256_mul_pd(_mm256_loadu_pd(samples + i + 4), _mm256_loadu_pd(keys + i + 4)));
+  }
+  double result = HorizontalSum(_mm256_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx2")))
+inline double WeightedSum(const float *samples, const double *keys, size_t number_of_values)
+{
+  __m256d sum_0 = _mm256_setzero_pd();
+  __m256d sum_1 = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum_0 = _mm256_add_pd(sum_0, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(samples + i)), _mm256_loadu_pd(keys + i)));
+    sum_1 = _mm256_add_pd(sum_1, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(samples + i + 4)), _mm256_loadu_pd(keys + i + 4)));
+  }
+  double result = HorizontalSum(_mm256_add_pd(sum_0, sum_1));
+  for (; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx2")))
+inline double Maximum(const double *values, size_t number_of_values)
+{
+  __m256d maximum = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    maximum = _mm256_max_pd(maximum, _mm256_loadu_pd(values + i));
+  }
+  __m128d half = _mm_max_pd(_mm256_castpd256_pd128(maximum), _mm256_extractf128_pd(maximum, 1));
+  double result = _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+  for (; i < number_of_values; ++i)
+  {
+    result = std::max(result, values[i]);
+  }
+  return result;
+}
+
+__attribute__((target("avx2")))
+inline size_t ArgMax(const double *values, size_t number_of_values)
+{
+  if (number_of_values == 0 || values[0] != values[0])
+  {
+    return 0;
+  }
+  __m256d maximum = _mm256_set1_pd(values[0]);
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    maximum = _mm256_max_pd(_mm256_loadu_pd(values + i), maximum);
+  }
+  __m128d half = _mm_max_pd(_mm256_castpd256_pd128(maximum), _mm256_extractf128_pd(maximum, 1));
+  double result = _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+  for (; i < number_of_values; ++i)
+  {
+    result = values[i] > result ? values[i] : result;
+  }
+  __m256d target = _mm256_set1_pd(result);
+  for (i = 0; i + 4 <= number_of_values; i += 4)
+  {
+    int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + i), target, _CMP_EQ_OQ));
+    if (mask)
+    {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  while (values[i] != result)
+  {
+    ++i;
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+inline void AddTo(double *sums, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    _mm256_storeu_pd(sums + i, _mm256_add_pd(_mm256_loadu_pd(sums + i), _mm256_loadu_pd(values + i)));
+  }
+  scalar::AddTo(sums + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("avx2")))
+inline void MultiplyAddTo(double *sums, const double *samples, const double *keys, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    _mm256_storeu_pd(sums + i, _mm256_add_pd(_mm256_loadu_pd(sums + i), _mm256_mul_pd(_mm256_loadu_pd(samples + i), _mm256_loadu_pd(keys + i))));
+  }
+  scalar::MultiplyAddTo(sums + i, samples + i, keys + i, number_of_values - i);
+}
+
+__attribute__((target("avx2")))
+inline void AddAbsoluteTo(double *sums, const double *values, size_t number_of_values)
+{
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    _mm256_storeu_pd(sums + i, _mm256_add_pd(_mm256_loadu_pd(sums + i), _mm256_andnot_pd(sign, _mm256_loadu_pd(values + i))));
+  }
+  scalar::AddAbsoluteTo(sums + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("avx2")))
+inline void MaximumTo(double *maxima, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    _mm256_storeu_pd(maxima + i, _mm256_max_pd(_mm256_loadu_pd(values + i), _mm256_loadu_pd(maxima + i)));
+  }
+  scalar::MaximumTo(maxima + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("avx2")))
+inline void SelectMaximumKey(double *maximum_keys, double *selected, const double *keys, const double *samples, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 4 <= number_of_values; i += 4)
+  {
+    __m256d key = _mm256_loadu_pd(keys + i);
+    __m256d maximum_key = _mm256_loadu_pd(maximum_keys + i);
+    __m256d greater = _mm256_cmp_pd(key, maximum_key, _CMP_GT_OQ);
+    _mm256_storeu_pd(maximum_keys + i, _mm256_blendv_pd(maximum_key, key, greater));
+    _mm256_storeu_pd(selected + i, _mm256_blendv_pd(_mm256_loadu_pd(selected + i), _mm256_loadu_pd(samples + i), greater));
+  }
+  scalar::SelectMaximumKey(maximum_keys + i, selected + i, keys + i, samples + i, number_of_values - i);
+}
+
+}
+
+//----------------------------------------------------------------------
+// AVX-512 kernels
+//----------------------------------------------------------------------
+// Some GCC versions warn about the deliberately undefined registers in their AVX-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+namespace avx512
+{
+
+__attribute__((target("avx512f")))
+inline double Sum(const double *values, size_t number_of_values)
+{
+  __m512d sum = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum = _mm512_add_pd(sum, _mm512_loadu_pd(values + i));
+  }
+  double result = _mm512_reduce_add_pd(sum);
+  for (; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx512f")))
+inline double Sum(const float *values, size_t number_of_values)
+{
+  __m512d sum = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum = _mm512_add_pd(sum, _mm512_cvtps_pd(_mm256_loadu_ps(values + i)));
+  }
+  double result = _mm512_reduce_add_pd(sum);
+  for (; i < number_of_values; ++i)
+  {
+    result += values[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx512f")))
+inline double WeightedSum(const double *samples, const double *keys, size_t number_of_values)
+{
+  __m512d sum = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_loadu_pd(samples + i), _mm512_loadu_pd(keys + i)));
+  }
+  double result = _mm512_reduce_add_pd(sum);
+  for (; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx512f")))
+inline double WeightedSum(const float *samples, const double *keys, size_t number_of_values)
+{
+  __m512d sum = _mm512_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_cvtps_pd(_mm256_loadu_ps(samples + i)), _mm512_loadu_pd(keys + i)));
+  }
+  double result = _mm512_reduce_add_pd(sum);
+  for (; i < number_of_values; ++i)
+  {
+    result += samples[i] * keys[i];
+  }
+  return result;
+}
+
+__attribute__((target("avx512f")))
+inline double Maximum(const double *values, size_t number_of_values)
+{
+  __m512d maximum = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    maximum = _mm512_max_pd(maximum, _mm512_loadu_pd(values + i));
+  }
+  double result = _mm512_reduce_max_pd(maximum);
+  for (; i < number_of_values; ++i)
+  {
+    result = std::max(result, values[i]);
+  }
+  return result;
+}
+
+__attribute__((target("avx512f")))
+inline size_t ArgMax(const double *values, size_t number_of_values)
+{
+  if (number_of_values == 0 || values[0] != values[0])
+  {
+    return 0;
+  }
+  __m512d maximum = _mm512_set1_pd(values[0]);
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    maximum = _mm512_max_pd(_mm512_loadu_pd(values + i), maximum);
+  }
+  double result = _mm512_reduce_max_pd(maximum);
+  for (; i < number_of_values; ++i)
+  {
+    result = values[i] > result ? values[i] : result;
+  }
+  __m512d target = _mm512_set1_pd(result);
+  for (i = 0; i + 8 <= number_of_values; i += 8)
+  {
+    __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(values + i), target, _CMP_EQ_OQ);
+    if (mask)
+    {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  while (values[i] != result)
+  {
+    ++i;
+  }
+  return i;
+}
+
+__attribute__((target("avx512f")))
+inline void AddTo(double *sums, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    _mm512_storeu_pd(sums + i, _mm512_add_pd(_mm512_loadu_pd(sums + i), _mm512_loadu_pd(values + i)));
+  }
+  scalar::AddTo(sums + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("avx512f")))
+inline void MultiplyAddTo(double *sums, const double *samples, const double *keys, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    _mm512_storeu_pd(sums + i, _mm512_add_pd(_mm512_loadu_pd(sums + i), _mm512_mul_pd(_mm512_loadu_pd(samples + i), _mm512_loadu_pd(keys + i))));
+  }
+  scalar::MultiplyAddTo(sums + i, samples + i, keys + i, number_of_values - i);
+}
+
+__attribute__((target("avx512f")))
+inline void AddAbsoluteTo(double *sums, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    _mm512_storeu_pd(sums + i, _mm512_add_pd(_mm512_loadu_pd(sums + i), _mm512_abs_pd(_mm512_loadu_pd(values + i))));
+  }
+  scalar::AddAbsoluteTo(sums + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("avx512f")))
+inline void MaximumTo(double *maxima, const double *values, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    _mm512_storeu_pd(maxima + i, _mm512_max_pd(_mm512_loadu_pd(values + i), _mm512_loadu_pd(maxima + i)));
+  }
+  scalar::MaximumTo(maxima + i, values + i, number_of_values - i);
+}
+
+__attribute__((target("avx512f")))
+inline void SelectMaximumKey(double *maximum_keys, double *selected, const double *keys, const double *samples, size_t number_of_values)
+{
+  size_t i = 0;
+  for (; i + 8 <= number_of_values; i += 8)
+  {
+    __m512d key = _mm512_loadu_pd(keys + i);
+    __m512d maximum_key = _mm512_loadu_pd(maximum_keys + i);
+    __mmask8 greater = _mm512_cmp_pd_mask(key, maximum_key, _CMP_GT_OQ);
+    _mm512_storeu_pd(maximum_keys + i, _mm512_mask_blend_pd(greater, maximum_key, key));
+    _mm512_storeu_pd(selected + i, _mm512_mask_blend_pd(greater, _mm512_loadu_pd(selected + i), _mm512_loadu_pd(samples + i)));
+  }
+  scalar::SelectMaximumKey(maximum_keys + i, selected + i, keys + i, samples + i, number_of_values - i);
+}
+
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+//----------------------------------------------------------------------
+// Runtime dispatch
+//----------------------------------------------------------------------
+struct tKernels
+{
+  const char *instruction_set;
+  double (*sum_double)(const double *, size_t);
+  double (*sum_float)(const float *, size_t);
+  double (*weighted_sum_double)(const double *, const double *, size_t);
+  double (*weighted_sum_float)(const float *, const double *, size_t);
+  double (*maximum)(const double *, size_t);
+  size_t (*arg_max)(const double *, size_t);
+  void (*add_to)(double *, const double *, size_t);
+  void (*multiply_add_to)(double *, const double *, const double *, size_t);
+  void (*add_absolute_to)(double *, const double *, size_t);
+  void (*maximum_to)(double *, const double *, size_t);
+  void (*select_maximum_key)(double *, double *, const double *, const double *, size_t);
+};
+
+inline tKernels ScalarKernels()
+{
+  tKernels kernels = { "scalar", &scalar::Sum<double>, &scalar::Sum<float>, &scalar::WeightedSum<double>, &scalar::WeightedSum<float>, &scalar::Maximum, &scalar::ArgMax,
+                       &scalar::AddTo<double, double>, &scalar::MultiplyAddTo<double, double>, &scalar::AddAbsoluteTo, &scalar::MaximumTo, &scalar::SelectMaximumKey<double>
+                     };
+  return kernels;
+}
+
+#ifdef __rrlib__data_fusion__simd__x86__
+inline tKernels SSE2Kernels()
+{
+  tKernels kernels = { "SSE2", &sse2::Sum, &sse2::Sum, &sse2::WeightedSum, &sse2::WeightedSum, &sse2::Maximum, &sse2::ArgMax,
+                       &sse2::AddTo, &sse2::MultiplyAddTo, &sse2::AddAbsoluteTo, &sse2::MaximumTo, &sse2::SelectMaximumKey
+                     };
+  return kernels;
+}
+
+inline tKernels AVX2Kernels()
+{
+  tKernels kernels = { "AVX2", &avx2::Sum, &avx2::Sum, &avx2::WeightedSum, &avx2::WeightedSum, &avx2::Maximum, &avx2::ArgMax,
+                       &avx2::AddTo, &avx2::MultiplyAddTo, &avx2::AddAbsoluteTo, &avx2::MaximumTo, &avx2::SelectMaximumKey
+                     };
+  return kernels;
+}
+
+inline tKernels AVX512Kernels()
+{
+  tKernels kernels = { "AVX-512", &avx512::Sum, &avx512::Sum, &avx512::WeightedSum, &avx512::WeightedSum, &avx512::Maximum, &avx512::ArgMax,
+                       &avx512::AddTo, &avx512::MultiplyAddTo, &avx512::AddAbsoluteTo, &avx512::MaximumTo, &avx512::SelectMaximumKey
+                     };
+  return kernels;
+}
+#endif
+
+//! The kernels of every instruction set this CPU supports, widest first
+inline std::vector<tKernels> SupportedKernels()
+{
+  std::vector<tKernels> result;
+#ifdef __rrlib__data_fusion__simd__x86__
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+  {
+    result.push_back(AVX512Kernels());
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    result.push_back(AVX2Kernels());
+  }
+  if (__builtin_cpu_supports("sse2"))
+  {
+    result.push_back(SSE2Kernels());
+  }
+#endif
+  result.push_back(ScalarKernels());
+  return result;
+}
+
+inline tKernels SelectKernels()
+{
+  return SupportedKernels().front();
+}
+
+inline const tKernels &Kernels()
+{
+  static const tKernels kernels = SelectKernels();
+  return kernels;
+}
+
+}
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+
+//! Name of the instruction set selected for this CPU
+inline const char *InstructionSet()
+{
+  return internal::Kernels().instruction_set;
+}
+
+inline double Sum(const double *values, size_t number_of_values)
+{
+  return internal::Kernels().sum_double(values, number_of_values);
+}
+
+inline double Sum(const float *values, size_t number_of_values)
+{
+  return internal::Kernels().sum_float(values, number_of_values);
+}
+
+//! Sum of samples[i] * keys[i]
+inline double WeightedSum(const double *samples, const double *keys, size_t number_of_values)
+{
+  return internal::Kernels().weighted_sum_double(samples, keys, number_of_values);
+}
+
+inline double WeightedSum(const float *samples, const double *keys, size_t number_of_values)
+{
+  return internal::Kernels().weighted_sum_float(samples, keys, number_of_values);
+}
+
+//! Maximum of the given values or -infinity if there are none
+inline double Maximum(const double *values, size_t number_of_values)
+{
+  return internal::Kernels().maximum(values, number_of_values);
+}
+
+//! Weighted sum with keys relative to the maximum key (see tWeightedSum)
+template <typename TSample>
+inline double MaximumNormalizedWeightedSum(const TSample *samples, const double *keys, size_t number_of_values)
+{
+  double maximum = std::max(0.0, Maximum(keys, number_of_values));
+  return maximum != 0.0 ? WeightedSum(samples, keys, number_of_values) / maximum : 0.0;
+}
+
+//! Index of the first maximum of the given values
+/*! Like tMaximumKey, a value only replaces the maximum if it is larger.
+ *  NaN is never larger, so the result is always a valid index.
+ */
+inline size_t ArgMax(const double *values, size_t number_of_values)
+{
+  return internal::Kernels().arg_max(values, number_of_values);
+}
+
+//! sums[i] += values[i] for each element
+inline void AddTo(double *sums, const double *values, size_t number_of_values)
+{
+  internal::Kernels().add_to(sums, values, number_of_values);
+}
+
+template <typename TSum, typename TValue>
+inline void AddTo(TSum *sums, const TValue *values, size_t number_of_values)
+{
+  internal::scalar::AddTo(sums, values, number_of_values);
+}
+
+//! sums[i] += samples[i] * keys[i] for each element
+inline void MultiplyAddTo(double *sums, const double *samples, const double *keys, size_t number_of_values)
+{
+  internal::Kernels().multiply_add_to(sums, samples, keys, number_of_values);
+}
+
+template <typename TSum, typename TSample>
+inline void MultiplyAddTo(TSum *sums, const TSample *samples, const double *keys, size_t number_of_values)
+{
+  internal::scalar::MultiplyAddTo(sums, samples, keys, number_of_values);
+}
+
+//! sums[i] += |values[i]| for each element
+inline void AddAbsoluteTo(double *sums, const double *values, size_t number_of_values)
+{
+  internal::Kernels().add_absolute_to(sums, values, number_of_values);
+}
+
+//! maxima[i] = std::max(maxima[i], values[i]) for each element
+inline void MaximumTo(double *maxima, const double *values, size_t number_of_values)
+{
+  internal::Kernels().maximum_to(maxima, values, number_of_values);
+}
+
+//! Replaces maximum_keys[i] and selected[i] by keys[i] and samples[i] where keys[i] is larger
+/*! The conditional select of tMaximumKey, one element per group. A NaN
+ *  key is never larger.
+ */
+inline void SelectMaximumKey(double *maximum_keys, double *selected, const double *keys, const double *samples, size_t number_of_values)
+{
+  internal::Kernels().select_maximum_key(maximum_keys, selected, keys, samples, number_of_values);
+}
+
+template <typename TSample>
+inline void SelectMaximumKey(double *maximum_keys, TSample *selected, const double *keys, const TSample *samples, size_t number_of_values)
+{
+  internal::scalar::SelectMaximumKey(maximum_keys, selected, keys, samples, number_of_values);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif
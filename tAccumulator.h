@@ -0,0 +1,308 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tAccumulator.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tAccumulator
+ *
+ * \b tAccumulator
+ *
+ * Weighted running sum of samples. Types whose operator+= does not add
+ * component-wise (angles and poses) are accumulated per component, like
+ * in the specializations of tAverage.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tAccumulator_h__
+#define __rrlib__data_fusion__tAccumulator_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+#include <new>
+
+#ifdef _LIB_RRLIB_MATH_PRESENT_
+#include "rrlib/math/tAngle.h"
+#include "rrlib/math/tPose2D.h"
+#include "rrlib/math/tPose3D.h"
+#endif
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Weighted running sum of samples
+/*! Samples can be added and removed again with their weight and the
+ *  accumulated value can be scaled, e.g. to let old samples decay. Result
+ *  returns the accumulated value scaled by a given factor, e.g. the
+ *  inverse of the accumulated weights for a weighted average.
+ */
+template <typename TSample>
+class tAccumulator
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tAccumulator()
+    : accumulated(Zero())
+  {}
+
+  inline void Clear()
+  {
+    this->accumulated = Zero();
+  }
+
+  inline void Add(const TSample &sample, double weight = 1)
+  {
+    this->accumulated += sample * weight;
+  }
+
+  inline void Remove(const TSample &sample, double weight = 1)
+  {
+    this->accumulated += sample * -weight;
+  }
+
+  inline void Scale(double factor)
+  {
+    this->accumulated = this->accumulated * factor;
+  }
+
+  inline const TSample Result(double factor) const
+  {
+    return this->accumulated * factor;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  TSample accumulated;
+
+  static const TSample Zero()
+  {
+    char buffer[sizeof(TSample)];
+    memset(buffer, 0, sizeof(buffer));
+    TSample *zero = new(buffer) TSample;
+    return *zero;
+  }
+
+};
+
+#ifdef _LIB_RRLIB_MATH_PRESENT_
+
+template <typename TElement, typename TUnitPolicy, typename TSignedPolicy>
+class tAccumulator<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>>
+{
+
+  typedef math::tAngle<TElement, TUnitPolicy, TSignedPolicy> tAngle;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tAccumulator()
+    : accumulated_value(0)
+  {}
+
+  inline void Clear()
+  {
+    this->accumulated_value = 0;
+  }
+
+  inline void Add(const tAngle &sample, double weight = 1)
+  {
+    this->accumulated_value += static_cast<double>(sample) * weight;
+  }
+
+  inline void Remove(const tAngle &sample, double weight = 1)
+  {
+    this->accumulated_value -= static_cast<double>(sample) * weight;
+  }
+
+  inline void Scale(double factor)
+  {
+    this->accumulated_value *= factor;
+  }
+
+  inline const tAngle Result(double factor) const
+  {
+    return tAngle(this->accumulated_value * factor);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  double accumulated_value;
+
+};
+
+template <>
+class tAccumulator<math::tPose2D>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tAccumulator()
+    : accumulated_yaw(0)
+  {}
+
+  inline void Clear()
+  {
+    this->accumulated_position = math::tVec2d();
+    this->accumulated_yaw = 0;
+  }
+
+  inline void Add(const math::tPose2D &sample, double weight = 1)
+  {
+    this->accumulated_position += sample.Position() * weight;
+    this->accumulated_yaw += static_cast<double>(sample.Yaw()) * weight;
+  }
+
+  inline void Remove(const math::tPose2D &sample, double weight = 1)
+  {
+    this->Add(sample, -weight);
+  }
+
+  inline void Scale(double factor)
+  {
+    this->accumulated_position = this->accumulated_position * factor;
+    this->accumulated_yaw *= factor;
+  }
+
+  inline const math::tPose2D Result(double factor) const
+  {
+    return math::tPose2D(this->accumulated_position * factor, math::tAngleRad(this->accumulated_yaw * factor));
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  math::tVec2d accumulated_position;
+  double accumulated_yaw;
+
+};
+
+template <>
+class tAccumulator<math::tPose3D>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tAccumulator()
+    : accumulated_roll(0),
+      accumulated_pitch(0),
+      accumulated_yaw(0)
+  {}
+
+  inline void Clear()
+  {
+    this->accumulated_position = math::tVec3d();
+    this->accumulated_roll = 0;
+    this->accumulated_pitch = 0;
+    this->accumulated_yaw = 0;
+  }
+
+  inline void Add(const math::tPose3D &sample, double weight = 1)
+  {
+    this->accumulated_position += sample.Position() * weight;
+    this->accumulated_roll += static_cast<double>(sample.Roll()) * weight;
+    this->accumulated_pitch += static_cast<double>(sample.Pitch()) * weight;
+    this->accumulated_yaw += static_cast<double>(sample.Yaw()) * weight;
+  }
+
+  inline void Remove(const math::tPose3D &sample, double weight = 1)
+  {
+    this->Add(sample, -weight);
+  }
+
+  inline void Scale(double factor)
+  {
+    this->accumulated_position = this->accumulated_position * factor;
+    this->accumulated_roll *= factor;
+    this->accumulated_pitch *= factor;
+    this->accumulated_yaw *= factor;
+  }
+
+  inline const math::tPose3D Result(double factor) const
+  {
+    return math::tPose3D(this->accumulated_position * factor, math::tAngleRad(this->accumulated_roll * factor), math::tAngleRad(this->accumulated_pitch * factor), math::tAngleRad(this->accumulated_yaw * factor));
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  math::tVec3d accumulated_position;
+  double accumulated_roll;
+  double accumulated_pitch;
+  double accumulated_yaw;
+
+};
+
+#endif
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -37,19 +37,17 @@
 #define __rrlib__data_fusion__tAverage_h__
 
 #include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#ifdef _LIB_RRLIB_MATH_PRESENT_
-#include "rrlib/math/tAngle.h"
-#include "rrlib/math/tPose2D.h"
-#include "rrlib/math/tPose3D.h"
-#endif
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
+#include "rrlib/data_fusion/simd.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -70,179 +68,129 @@ namespace data_fusion
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of tAverageBase
-/*! A more detailed description of tAverageBase, which
- *  Tobias Foehst hasn't done yet !!
- */
+namespace internal
+{
+
+//! Implementation shared by tAverage and tStaticAverage
 template <
 typename TSample,
-         template <typename> class TChannel = channel::LastValue
+         template <typename> class TChannel,
+         typename TBase
          >
-class tAverage : public tDataFusion<TSample, TChannel>
+class tAverage : public TBase
 {
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource)
+  {}
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  virtual const char *GetLogDescription() const
+  const char *GetLogDescription() const
   {
     return "tAverage";
   }
 
-  virtual const bool HasValidState() const
+  const bool HasValidState() const
   {
     return true;
   }
 
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels)
-  {
-    char buffer[sizeof(TSample)];
-    memset(buffer, 0, sizeof(buffer));
-    TSample *accumulated = new(buffer) TSample;
-    for (typename std::vector<TChannel<TSample>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      *accumulated += it->GetSample();
-    }
-    return *accumulated * (1.0 / channels.size());
-  }
-
-  virtual void ResetStateImplementation()
-  {}
-
-  virtual void EnterNextTimestepImplementation()
-  {}
-
-};
-
-#ifdef _LIB_RRLIB_MATH_PRESENT_
-
-template <typename TElement, typename TUnitPolicy, typename TSignedPolicy, template <typename> class TChannel>
-class tAverage<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>, TChannel> : public tDataFusion<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>, TChannel>
-{
-
-  typedef math::tAngle<TElement, TUnitPolicy, TSignedPolicy> tAngle;
-
-//----------------------------------------------------------------------
-// Private fields and methods
-//----------------------------------------------------------------------
-private:
-
-  virtual const char *GetLogDescription() const
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
   {
-    return "tWeightedAverage<math::tAngle<...>>";
+    return this->CalculateFusedValue(channels, simd::tHasKernels<typename TBase::tChannels>());
   }
 
-  virtual const bool HasValidState() const
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::true_type)
   {
-    return true;
+    return TSample(simd::Sum(channels.Samples(), channels.size()) * (1.0 / channels.size()));
   }
 
-  virtual const tAngle CalculateFusedValue(const std::vector<TChannel<tAngle>> &channels)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::false_type)
   {
-    double accumulated_value = 0;
-    for (typename std::vector<TChannel<tAngle>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      accumulated_value += static_cast<double>(it->GetSample());
-    }
-    return tAngle(accumulated_value / channels.size());
+    return kernels::Average<TSample>(kernels::ChannelSamples(channels.begin()), kernels::ChannelSamples(channels.end()));
   }
 
-  virtual void ResetStateImplementation()
+  void ResetStateImplementation()
   {}
 
-  virtual void EnterNextTimestepImplementation()
+  void EnterNextTimestepImplementation()
   {}
 
 };
 
-template <template <typename> class TChannel>
-class tAverage<math::tPose2D, TChannel> : public tDataFusion<math::tPose2D, TChannel>
+}
+
+//! Short description of tAverageBase
+/*! A more detailed description of tAverageBase, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tAverage : public internal::tAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>
 {
 
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
-
-  virtual const char *GetLogDescription() const
-  {
-    return "tAverage<tPose2D>";
-  }
-
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
-
-  virtual const math::tPose2D CalculateFusedValue(const std::vector<TChannel<math::tPose2D>> &channels)
-  {
-    math::tVec2d accumulated_position;
-    math::tAngle<double, math::angle::Radian, math::angle::NoWrap> accumulated_yaw;
-    for (typename std::vector<TChannel<math::tPose2D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      accumulated_position += it->GetSample().Position();
-      accumulated_yaw += it->GetSample().Yaw();
-    }
-    double factor = 1.0 / channels.size();
-    return math::tPose2D(accumulated_position * factor, math::tAngleRad(accumulated_yaw * factor));
-  }
-
-  virtual void ResetStateImplementation()
-  {}
+public:
 
-  virtual void EnterNextTimestepImplementation()
+  explicit tAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
   {}
 
 };
 
-template <template <typename> class TChannel>
-class tAverage<math::tPose3D, TChannel> : public tDataFusion<math::tPose3D, TChannel>
+//! Statically dispatched variant of tAverage
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticAverage : public internal::tAverage<TSample, TChannel, tStaticDataFusion<tStaticAverage<TSample, TChannel>, TSample, TChannel>>
 {
 
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
+public:
 
-  virtual const char *GetLogDescription() const
-  {
-    return "tAverage<tPose3D>";
-  }
+  explicit tStaticAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tAverage<TSample, TChannel, tStaticDataFusion<tStaticAverage<TSample, TChannel>, TSample, TChannel>>(resource)
+  {}
 
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
+};
 
-  virtual const math::tPose3D CalculateFusedValue(const std::vector<TChannel<math::tPose3D>> &channels)
-  {
-    math::tVec3d accumulated_position;
-    double accumulated_roll = 0;
-    double accumulated_pitch = 0;
-    double accumulated_yaw = 0;
-    for (typename std::vector<TChannel<math::tPose3D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      accumulated_position += it->GetSample().Position();
-      accumulated_roll += it->GetSample().Roll();
-      accumulated_pitch += it->GetSample().Pitch();
-      accumulated_yaw += it->GetSample().Yaw();
-    }
-    double factor = 1.0 / channels.size();
-    return math::tPose3D(accumulated_position * factor, math::tAngleRad(accumulated_roll * factor), math::tAngleRad(accumulated_pitch * factor), math::tAngleRad(accumulated_yaw * factor));
-  }
+//! Variant of tStaticAverage with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedAverage : public internal::tAverage<TSample, TChannel, tFixedDataFusion<tFixedAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
 
-  virtual void ResetStateImplementation()
-  {}
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
 
-  virtual void EnterNextTimestepImplementation()
+  explicit tFixedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tAverage<TSample, TChannel, tFixedDataFusion<tFixedAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
   {}
 
 };
 
-#endif
-
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
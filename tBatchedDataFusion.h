@@ -0,0 +1,293 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tBatchedDataFusion.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tBatchedDataFusion
+ *
+ * \b tBatchedDataFusion
+ *
+ * Many independent fusion problems of the same size (groups) computed in
+ * one pass. Samples and keys of all groups are stored channel by channel,
+ * so the groups of one channel are contiguous. The batch strategies
+ * process one channel at a time with the element-wise kernels of simd.h,
+ * which put the groups into SIMD lanes. For double samples, the kernels
+ * of the widest instruction set available are used; other sample types
+ * use scalar loops. The batched weighted sum normalizes each group once
+ * like simd::MaximumNormalizedWeightedSum, so it may differ from
+ * tWeightedSum in the last bits.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tBatchedDataFusion_h__
+#define __rrlib__data_fusion__tBatchedDataFusion_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/policies/batch/Average.h"
+#include "rrlib/data_fusion/policies/batch/WeightedAverage.h"
+#include "rrlib/data_fusion/policies/batch/WeightedSum.h"
+#include "rrlib/data_fusion/policies/batch/MaximumKey.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Batch of independent fusion groups with the same number of channels
+/*! TStrategy is one of the batch policies (batch::Average,
+ *  batch::WeightedAverage, batch::WeightedSum, batch::MaximumKey) and
+ *  yields the same results as the corresponding fuser applied to each
+ *  group. Only arithmetic sample types are supported.
+ *
+ *  All memory, including the buffers of the strategy, is allocated from
+ *  the resource given to the constructor.
+ *
+ *  Groups are independent: a group is valid as soon as all of its
+ *  channels are, regardless of the other groups.
+ */
+template <
+typename TSample,
+         template <typename> class TStrategy = batch::Average
+         >
+class tBatchedDataFusion
+{
+  static_assert(std::is_arithmetic<TSample>::value, "Batched data fusion is only available for arithmetic sample types");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef TSample tSample;
+
+  tBatchedDataFusion(size_t number_of_groups = 0, size_t number_of_channels = 0, tMemoryResource &resource = GetDefaultMemoryResource())
+    : number_of_groups(0),
+      number_of_channels(0),
+      samples(tAllocator<TSample>(resource)),
+      keys(tAllocator<double>(resource)),
+      valid(tAllocator<uint8_t>(resource)),
+      number_of_valid_channels(tAllocator<size_t>(resource)),
+      valid_groups(tAllocator<uint8_t>(resource)),
+      number_of_valid_groups(0),
+      fused_values(tAllocator<TSample>(resource)),
+      strategy(resource),
+      data_changed(true)
+  {
+    this->Resize(number_of_groups, number_of_channels);
+  }
+
+  inline size_t NumberOfGroups() const
+  {
+    return this->number_of_groups;
+  }
+
+  inline size_t NumberOfChannels() const
+  {
+    return this->number_of_channels;
+  }
+
+  //! Changes the layout of the batch and invalidates all channels
+  void Resize(size_t number_of_groups, size_t number_of_channels)
+  {
+    this->number_of_groups = number_of_groups;
+    this->number_of_channels = number_of_channels;
+    this->samples.assign(number_of_groups * number_of_channels, TSample(0));
+    this->keys.assign(number_of_groups * number_of_channels, 0);
+    this->valid.assign(number_of_groups * number_of_channels, 0);
+    this->number_of_valid_channels.assign(number_of_groups, 0);
+    this->valid_groups.assign(number_of_groups, 0);
+    this->number_of_valid_groups = 0;
+    this->fused_values.resize(number_of_groups);
+    this->data_changed = true;
+  }
+
+  void UpdateChannel(size_t group, size_t channel, const tSample &sample, double key = 1)
+  {
+    if (group >= this->number_of_groups || channel >= this->number_of_channels)
+    {
+      throw std::runtime_error("Channel does not exist in batched fusion object!");
+    }
+    size_t index = channel * this->number_of_groups + group;
+    this->samples[index] = sample;
+    this->keys[index] = key;
+    this->MarkValid(index, group);
+    this->data_changed = true;
+  }
+
+  /*! Updates one channel of all groups at once. samples and keys (if
+   *  given) must contain one element per group.
+   */
+  void UpdateAllGroups(size_t channel, const tSample *samples, const double *keys = 0)
+  {
+    if (channel >= this->number_of_channels)
+    {
+      throw std::runtime_error("Channel does not exist in batched fusion object!");
+    }
+    size_t offset = channel * this->number_of_groups;
+    std::copy(samples, samples + this->number_of_groups, this->samples.begin() + offset);
+    if (keys)
+    {
+      std::copy(keys, keys + this->number_of_groups, this->keys.begin() + offset);
+    }
+    else
+    {
+      std::fill(this->keys.begin() + offset, this->keys.begin() + offset + this->number_of_groups, 1.0);
+    }
+    for (size_t group = 0; group < this->number_of_groups; ++group)
+    {
+      this->MarkValid(offset + group, group);
+    }
+    this->data_changed = true;
+  }
+
+  inline const bool IsValid(size_t group) const
+  {
+    return this->valid_groups[group];
+  }
+
+  //! Whether all groups are valid
+  const bool IsValid() const
+  {
+    this->CheckNumberOfChannels();
+    return this->number_of_valid_groups == this->number_of_groups;
+  }
+
+  //! One element per group that is non-zero if the group is valid
+  inline const uint8_t *ValidGroups() const
+  {
+    return this->valid_groups.data();
+  }
+
+  /*! The fused values of all groups. Only the values of valid groups (see
+   *  ValidGroups) are meaningful, the others are fused from whatever
+   *  their channels contain.
+   */
+  const tSample *FusedValues()
+  {
+    this->CheckNumberOfChannels();
+    if (this->data_changed)
+    {
+      this->strategy.Fuse(this->samples.data(), this->keys.data(), this->number_of_groups, this->number_of_channels, this->fused_values.data());
+      this->data_changed = false;
+    }
+    return this->fused_values.data();
+  }
+
+  //! The fused value of group, which only has to be valid itself
+  inline const tSample &FusedValue(size_t group)
+  {
+    if (group >= this->number_of_groups)
+    {
+      throw std::runtime_error("Group does not exist in batched fusion object!");
+    }
+    this->CheckNumberOfChannels();
+    if (!this->IsValid(group))
+    {
+      throw std::runtime_error("Fused value not available with invalid state!");
+    }
+    return this->FusedValues()[group];
+  }
+
+  void ClearChannels()
+  {
+    std::fill(this->valid.begin(), this->valid.end(), 0);
+    std::fill(this->number_of_valid_channels.begin(), this->number_of_valid_channels.end(), 0);
+    std::fill(this->valid_groups.begin(), this->valid_groups.end(), 0);
+    this->number_of_valid_groups = 0;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  size_t number_of_groups;
+  size_t number_of_channels;
+  std::vector<TSample, tAllocator<TSample>> samples;
+  std::vector<double, tAllocator<double>> keys;
+  std::vector<uint8_t, tAllocator<uint8_t>> valid;
+  std::vector<size_t, tAllocator<size_t>> number_of_valid_channels;
+  std::vector<uint8_t, tAllocator<uint8_t>> valid_groups;
+  size_t number_of_valid_groups;
+  std::vector<TSample, tAllocator<TSample>> fused_values;
+  TStrategy<TSample> strategy;
+  bool data_changed;
+
+  inline void MarkValid(size_t index, size_t group)
+  {
+    if (!this->valid[index])
+    {
+      this->valid[index] = 1;
+      if (++this->number_of_valid_channels[group] == this->number_of_channels)
+      {
+        this->valid_groups[group] = 1;
+        this->number_of_valid_groups++;
+      }
+    }
+  }
+
+  inline void CheckNumberOfChannels() const
+  {
+    if (this->number_of_channels == 0)
+    {
+      throw std::logic_error("Number of channels must be greater than zero!");
+    }
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
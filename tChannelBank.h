@@ -0,0 +1,309 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tChannelBank.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tChannelBank
+ *
+ * \b tChannelBank
+ *
+ * Structure-of-arrays storage for channels with LastValue semantics.
+ * Samples and keys are kept in two contiguous arrays and the validity
+ * of the channels in a packed bitmask, so fusion loops run with unit
+ * stride over dense data instead of striding over channel objects.
+ *
+ * The bank is selected by using channel::Dense as channel policy.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tChannelBank_h__
+#define __rrlib__data_fusion__tChannelBank_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+namespace channel
+{
+template <typename TSample>
+class Dense;
+}
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Structure-of-arrays channel storage
+/*! Provides the subset of the std::vector interface that is used by the
+ *  fusion classes. Element access yields channel::Dense<TSample> objects,
+ *  which refer to one channel of the bank and offer the interface of a
+ *  channel policy.
+ */
+template <typename TSample>
+class tChannelBank
+{
+
+  template <bool Tconst>
+  class tIterator;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef channel::Dense<TSample> value_type;
+  typedef tIterator<false> iterator;
+  typedef tIterator<true> const_iterator;
+
+  inline size_t size() const
+  {
+    return this->samples.size();
+  }
+
+  inline bool empty() const
+  {
+    return this->samples.empty();
+  }
+
+  void resize(size_t number_of_channels)
+  {
+    if (number_of_channels < this->samples.size() && !this->valid_mask.empty())
+    {
+      for (size_t i = number_of_channels; i < std::min(this->samples.size(), (number_of_channels + 63) & ~size_t(63)); ++i)
+      {
+        this->SetValid(i, false);
+      }
+    }
+    this->samples.resize(number_of_channels);
+    this->keys.resize(number_of_channels);
+    this->valid_mask.resize((number_of_channels + 63) / 64, 0);
+  }
+
+  inline value_type operator[](size_t channel)
+  {
+    return value_type(*this, channel);
+  }
+
+  inline const value_type operator[](size_t channel) const
+  {
+    return value_type(const_cast<tChannelBank &>(*this), channel);
+  }
+
+  inline iterator begin()
+  {
+    return iterator(*this, 0);
+  }
+
+  inline iterator end()
+  {
+    return iterator(*this, this->size());
+  }
+
+  inline const_iterator begin() const
+  {
+    return const_iterator(const_cast<tChannelBank &>(*this), 0);
+  }
+
+  inline const_iterator end() const
+  {
+    return const_iterator(const_cast<tChannelBank &>(*this), this->size());
+  }
+
+  inline const TSample *Samples() const
+  {
+    return this->samples.data();
+  }
+
+  inline const double *Keys() const
+  {
+    return this->keys.data();
+  }
+
+  inline bool IsValid(size_t channel) const
+  {
+    return (this->valid_mask[channel / 64] >> (channel % 64)) & 1;
+  }
+
+  inline void SetValid(size_t channel, bool valid)
+  {
+    uint64_t bit = uint64_t(1) << (channel % 64);
+    this->valid_mask[channel / 64] = valid ? (this->valid_mask[channel / 64] | bit) : (this->valid_mask[channel / 64] & ~bit);
+  }
+
+  inline void Assign(size_t channel, const TSample &sample, double key)
+  {
+    this->samples[channel] = sample;
+    this->keys[channel] = key;
+    this->SetValid(channel, true);
+  }
+
+  /*! Assigns samples and keys to number_of_channels consecutive channels
+   *  starting at first_channel and marks them as valid. If keys is null,
+   *  all keys are set to 1.
+   *
+   *  \returns The number of channels that have not been valid before
+   */
+  size_t Assign(size_t first_channel, const TSample *samples, const double *keys, size_t number_of_channels)
+  {
+    size_t end_channel = first_channel + number_of_channels;
+    std::copy(samples, samples + number_of_channels, this->samples.begin() + first_channel);
+    if (keys)
+    {
+      std::copy(keys, keys + number_of_channels, this->keys.begin() + first_channel);
+    }
+    else
+    {
+      std::fill(this->keys.begin() + first_channel, this->keys.begin() + end_channel, 1.0);
+    }
+
+    size_t newly_valid = 0;
+    for (size_t word = first_channel / 64; word * 64 < end_channel; ++word)
+    {
+      size_t low = std::max(word * 64, first_channel) - word * 64;
+      size_t high = std::min(word * 64 + 64, end_channel) - word * 64;
+      uint64_t bits = (high - low == 64) ? ~uint64_t(0) : ((uint64_t(1) << (high - low)) - 1) << low;
+      newly_valid += __builtin_popcountll(bits & ~this->valid_mask[word]);
+      this->valid_mask[word] |= bits;
+    }
+    return newly_valid;
+  }
+
+  inline const TSample &Sample(size_t channel) const
+  {
+    return this->samples[channel];
+  }
+
+  inline double Key(size_t channel) const
+  {
+    return this->keys[channel];
+  }
+
+  void ClearValidity()
+  {
+    std::fill(this->valid_mask.begin(), this->valid_mask.end(), 0);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<TSample, tAllocator<TSample>> samples;
+  std::vector<double, tAllocator<double>> keys;
+  std::vector<uint64_t, tAllocator<uint64_t>> valid_mask;
+
+};
+
+//----------------------------------------------------------------------
+// tChannelBank iterator
+//----------------------------------------------------------------------
+template <typename TSample>
+template <bool Tconst>
+class tChannelBank<TSample>::tIterator
+{
+  typedef typename std::conditional<Tconst, const channel::Dense<TSample>, channel::Dense<TSample>>::type tChannel;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tIterator(tChannelBank &bank, size_t channel)
+    : channel(bank, channel)
+  {}
+
+  inline tChannel &operator*() const
+  {
+    return this->channel;
+  }
+
+  inline tChannel *operator->() const
+  {
+    return &this->channel;
+  }
+
+  inline tIterator &operator++()
+  {
+    this->channel.channel++;
+    return *this;
+  }
+
+  inline tIterator operator++(int)
+  {
+    tIterator result(*this);
+    ++*this;
+    return result;
+  }
+
+  inline bool operator==(const tIterator &other) const
+  {
+    return this->channel.channel == other.channel.channel;
+  }
+
+  inline bool operator!=(const tIterator &other) const
+  {
+    return this->channel.channel != other.channel.channel;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  mutable channel::Dense<TSample> channel;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
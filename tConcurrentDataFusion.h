@@ -0,0 +1,402 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tConcurrentDataFusion.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tConcurrentDataFusion
+ *
+ * \b tConcurrentDataFusion
+ *
+ * Wraps a fusion object so that its channels can be updated from several
+ * threads without locking. Every channel has a triple buffer with one
+ * writer (the sensor thread of this channel) and one reader (the thread
+ * that queries the fused value). Writers and the reader never wait for
+ * each other and samples can not be torn. Writers queue the channels
+ * they updated, so the reader only visits those. Updates of several
+ * channels can be published as one batch, which the reader sees either
+ * completely or not at all.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tConcurrentDataFusion_h__
+#define __rrlib__data_fusion__tConcurrentDataFusion_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Data fusion with lock-free concurrent channel updates
+/*! UpdateChannel may be called concurrently for different channels, but
+ *  each channel must only be written by one thread at a time. All other
+ *  methods belong to a single reader thread. The reader takes over the
+ *  latest sample of every channel that was written since its last call
+ *  and passes them to the wrapped TFusion object (e.g. tStaticAverage or
+ *  tFixedMedianVoter), which is only accessed by the reader.
+ *
+ *  UpdateChannels writes a batch of channels. Writers count the batches
+ *  they begin and end, and the two counters form an epoch like a
+ *  seqlock. The reader first checks that no batch is being written. It
+ *  then takes over the queued channels and checks that no batch began
+ *  meanwhile. Only then does it pass the channels it took over to the
+ *  fusion object. Otherwise it keeps them pending and defers them to a
+ *  later call. The fused value therefore always reflects complete
+ *  batches. As the reader never waits, it keeps its previous state while
+ *  batches overlap continuously. Single UpdateChannel calls do not take
+ *  part in the epoch: the reader may see some of several individually
+ *  updated channels before the others.
+ *
+ *  SetNumberOfChannels must not be called while writers are active.
+ */
+template <typename TFusion>
+class tConcurrentDataFusion
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename TFusion::tSample tSample;
+
+  //! The wrapped fusion object and the slots allocate from resource
+  explicit tConcurrentDataFusion(tMemoryResource &resource = GetDefaultMemoryResource())
+    : fusion(resource),
+      slots(resource),
+      fresh_channels(resource),
+      pending_channels(resource)
+  {
+    this->CreateSlots();
+  }
+
+  explicit tConcurrentDataFusion(size_t number_of_channels, tMemoryResource &resource = GetDefaultMemoryResource())
+    : fusion(resource),
+      slots(resource),
+      fresh_channels(resource),
+      pending_channels(resource)
+  {
+    this->SetNumberOfChannels(number_of_channels);
+  }
+
+  inline size_t NumberOfChannels() const
+  {
+    return this->number_of_slots;
+  }
+
+  void SetNumberOfChannels(size_t number_of_channels)
+  {
+    this->fusion.SetNumberOfChannels(number_of_channels);
+    this->CreateSlots();
+  }
+
+  //! Lock-free and wait-free, may be called by the writer of the given channel
+  void UpdateChannel(size_t channel, const tSample &sample, double key = 1)
+  {
+    this->CheckChannelRange(channel, 1);
+    this->WriteSlot(channel, sample, key);
+  }
+
+  /*! Updates the consecutive channels starting at first_channel as one
+   *  batch, which the reader takes over either completely or not at all.
+   *  Lock-free and wait-free. The calling thread must be the writer of
+   *  all these channels.
+   */
+  void UpdateChannels(size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples)
+  {
+    this->CheckChannelRange(first_channel, number_of_samples);
+    tBatch batch(*this);
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      this->WriteSlot(first_channel + i, samples[i], keys ? keys[i] : 1);
+    }
+  }
+
+  inline void UpdateChannels(size_t first_channel, const tSample *samples, size_t number_of_samples)
+  {
+    this->UpdateChannels(first_channel, samples, 0, number_of_samples);
+  }
+
+  inline const tSample &FusedValue()
+  {
+    this->Synchronize();
+    return this->fusion.FusedValue();
+  }
+
+  inline const bool IsValid()
+  {
+    this->Synchronize();
+    return this->fusion.IsValid();
+  }
+
+  inline size_t NumberOfValidChannels()
+  {
+    this->Synchronize();
+    return this->fusion.NumberOfValidChannels();
+  }
+
+  inline void ClearChannels()
+  {
+    this->Synchronize();
+    this->fusion.ClearChannels();
+  }
+
+  inline void ResetState()
+  {
+    this->Synchronize();
+    this->fusion.ResetState();
+  }
+
+  inline void EnterNextTimestep()
+  {
+    this->Synchronize();
+    this->fusion.EnterNextTimestep();
+  }
+
+  //! The wrapped fusion object, e.g. for configuration (reader only)
+  inline TFusion &Fusion()
+  {
+    return this->fusion;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cINDEX = 3, cFRESH = 4 };
+
+  struct tEntry
+  {
+    tSample sample;
+    double key;
+  };
+
+  /*! Triple buffer of one channel. The writer owns buffers[back], the
+   *  reader buffers[front]. middle holds the index of the third buffer and
+   *  the cFRESH flag if it contains a sample the reader has not seen yet.
+   *  The padding keeps adjacent slots off the same cache line.
+   */
+  struct tSlot
+  {
+    tEntry buffers[3];
+    std::atomic<uint8_t> middle;
+    uint8_t back;
+    uint8_t front;
+    uint8_t pending;   // buffers[front] was not passed to the fusion object yet
+    char padding[64];
+
+    tSlot()
+      : middle(1),
+        back(0),
+        front(2),
+        pending(0)
+    {}
+  };
+
+  //! Counts a batch as begun while in scope and as ended afterwards, even if a sample can not be copied
+  class tBatch
+  {
+  public:
+
+    explicit tBatch(tConcurrentDataFusion &fusion)
+      : fusion(fusion)
+    {
+      this->fusion.begun_batches.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    ~tBatch()
+    {
+      this->fusion.ended_batches.fetch_add(1, std::memory_order_release);
+    }
+
+  private:
+
+    tConcurrentDataFusion &fusion;
+
+    tBatch(const tBatch &);
+    tBatch &operator=(const tBatch &);
+  };
+
+  TFusion fusion;
+  tResourceArray<tSlot> slots;
+  size_t number_of_slots;
+
+  /*! Ring of the channels whose cFRESH flag was set, stored as index + 1
+   *  (0 marks an empty entry). A channel is only queued when its flag
+   *  changes from clear to set, and the flag is only cleared after the
+   *  reader dequeued the channel. So every channel is queued at most once
+   *  and number_of_slots entries suffice.
+   */
+  tResourceArray<std::atomic<size_t>> fresh_channels;
+  size_t fresh_begin;
+  tResourceArray<size_t> pending_channels;
+  size_t number_of_pending_channels;
+  char padding[64];
+  std::atomic<size_t> fresh_end;
+  std::atomic<size_t> begun_batches;
+  std::atomic<size_t> ended_batches;
+
+  void CreateSlots()
+  {
+    this->number_of_slots = this->fusion.NumberOfChannels();
+    this->slots.Reset(this->number_of_slots);
+    this->fresh_channels.Reset(this->number_of_slots);
+    for (size_t i = 0; i < this->number_of_slots; ++i)
+    {
+      this->fresh_channels[i].store(0, std::memory_order_relaxed);
+    }
+    this->fresh_begin = 0;
+    this->fresh_end.store(0, std::memory_order_relaxed);
+    this->pending_channels.Reset(this->number_of_slots);
+    this->number_of_pending_channels = 0;
+    this->begun_batches.store(0, std::memory_order_relaxed);
+    this->ended_batches.store(0, std::memory_order_relaxed);
+  }
+
+  void CheckChannelRange(size_t first_channel, size_t number_of_channels) const
+  {
+    if (first_channel + number_of_channels > this->number_of_slots || first_channel + number_of_channels < first_channel)
+    {
+      std::stringstream stream;
+      if (number_of_channels > 1)
+      {
+        stream << "Channels " << first_channel << " to " << first_channel + (number_of_channels - 1) << " do not all exist";
+      }
+      else
+      {
+        stream << "Channel " << first_channel << " does not exist";
+      }
+      stream << " in fusion object with " << this->number_of_slots << " channel" << (this->number_of_slots == 1 ? "" : "s") << "!";
+      throw std::runtime_error(stream.str());
+    }
+  }
+
+  inline void WriteSlot(size_t channel, const tSample &sample, double key)
+  {
+    tSlot &slot = this->slots[channel];
+    slot.buffers[slot.back].sample = sample;
+    slot.buffers[slot.back].key = key;
+    uint8_t middle = slot.middle.exchange(slot.back | cFRESH, std::memory_order_acq_rel);
+    slot.back = middle & cINDEX;
+    if (!(middle & cFRESH))
+    {
+      this->QueueFreshChannel(channel);
+    }
+  }
+
+  inline void QueueFreshChannel(size_t channel)
+  {
+    // acq_rel orders reusing an entry after the reader emptied it
+    size_t position = this->fresh_end.fetch_add(1, std::memory_order_acq_rel);
+    this->fresh_channels[position % this->number_of_slots].store(channel + 1, std::memory_order_release);
+  }
+
+  /*! Passes the queued channels to the fusion object if no batch was
+   *  written while they were taken over (see class description).
+   */
+  void Synchronize()
+  {
+    if (this->number_of_slots == 0)
+    {
+      return;
+    }
+    size_t ended_batches = this->ended_batches.load(std::memory_order_acquire);
+    if (this->begun_batches.load(std::memory_order_acquire) != ended_batches)
+    {
+      return;
+    }
+    this->TakeOverFreshChannels();
+    // A batch slot that was taken over also makes the begun batch visible here
+    if (this->begun_batches.load(std::memory_order_acquire) != ended_batches)
+    {
+      return;
+    }
+    for (size_t i = 0; i < this->number_of_pending_channels; ++i)
+    {
+      size_t channel = this->pending_channels[i];
+      tSlot &slot = this->slots[channel];
+      slot.pending = 0;
+      this->fusion.UpdateChannel(channel, slot.buffers[slot.front].sample, slot.buffers[slot.front].key);
+    }
+    this->number_of_pending_channels = 0;
+  }
+
+  //! Moves the queued channels to the front buffers. Stops at an entry that a writer reserved but did not fill yet.
+  void TakeOverFreshChannels()
+  {
+    for (;; ++this->fresh_begin)
+    {
+      std::atomic<size_t> &entry = this->fresh_channels[this->fresh_begin % this->number_of_slots];
+      size_t channel = entry.load(std::memory_order_acquire);
+      if (channel == 0)
+      {
+        return;
+      }
+      entry.store(0, std::memory_order_relaxed);
+      tSlot &slot = this->slots[--channel];
+      slot.front = slot.middle.exchange(slot.front, std::memory_order_acq_rel) & cINDEX;
+      if (!slot.pending)
+      {
+        slot.pending = 1;
+        this->pending_channels[this->number_of_pending_channels++] = channel;
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
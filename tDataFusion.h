@@ -39,13 +39,11 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include <stdexcept>
-#include <vector>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
-#include "rrlib/data_fusion/policies/channel/LastValue.h"
+#include "rrlib/data_fusion/tStaticDataFusion.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -74,74 +72,41 @@ template <
 typename TSample,
          template <typename> class TChannel = channel::LastValue
          >
-class tDataFusion
+class tDataFusion : public tStaticDataFusion<tDataFusion<TSample, TChannel>, TSample, TChannel>
 {
+  friend class tStaticDataFusion<tDataFusion<TSample, TChannel>, TSample, TChannel>;
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
 //----------------------------------------------------------------------
 public:
 
-  typedef TSample tSample;
+  typedef typename tStaticDataFusion<tDataFusion<TSample, TChannel>, TSample, TChannel>::tChannels tChannels;
 
-  virtual ~tDataFusion() = 0;
-
-  inline size_t NumberOfChannels() const
-  {
-    return this->channels.size();
-  }
-
-  void SetNumberOfChannels(size_t number_of_channels);
+  explicit tDataFusion(tMemoryResource &resource = GetDefaultMemoryResource())
+    : tStaticDataFusion<tDataFusion<TSample, TChannel>, TSample, TChannel>(resource)
+  {}
 
-  void UpdateChannel(size_t channel, const tSample &sample, double key = 1);
-
-  template <typename TSampleIterator>
-  void UpdateAllChannels(TSampleIterator begin_samples, TSampleIterator end_samples);
-
-  template <typename TSampleIterator, typename TKeyIterator>
-  void UpdateAllChannels(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys);
-
-  inline const tSample &FusedValue()
-  {
-    if (!this->IsValid())
-    {
-      throw std::runtime_error("Fused value not available with invalid state!");
-    }
-    if (this->data_changed)
-    {
-      this->fused_value = this->CalculateFusedValue(this->channels);
-      this->data_changed = false;
-    }
-    return this->fused_value;
-  }
-
-  const bool IsValid() const;
-
-  void ClearChannels();
-
-  void ResetState();
-
-  void EnterNextTimestep();
+  virtual ~tDataFusion() = 0;
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  std::vector<TChannel<TSample>> channels;
-  TSample fused_value;
-  bool data_changed;
-
   virtual const char *GetLogDescription() const
   {
     return "tDataFusion";
   }
 
   virtual const bool HasValidState() const = 0;
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels) = 0;
+  virtual const TSample CalculateFusedValue(const tChannels &channels) = 0;
   virtual void ResetStateImplementation() = 0;
   virtual void EnterNextTimestepImplementation() = 0;
 
+  virtual void UpdateChannelImplementation(const tChannels &, size_t)
+  {}
+
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,372 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tExpiringDataFusion.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tExpiringDataFusion
+ *
+ * \b tExpiringDataFusion
+ *
+ * Wraps a fusion object so that every channel update carries a
+ * timestamp. Channels whose last update is older than a maximum age drop
+ * out of fusion automatically. They come back with their next update.
+ * The channels are kept in a min-heap ordered by their timestamps, so
+ * finding the expired channels when reading costs O(log N) per expired
+ * channel. Removing an expired channel from the wrapped fusion object or
+ * adding a returning one only touches that channel. There is no sweep
+ * over all channels.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tExpiringDataFusion_h__
+#define __rrlib__data_fusion__tExpiringDataFusion_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/policies/channel/LastValue.h"
+#include "rrlib/data_fusion/policies/channel/Dense.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Whether a channel policy only keeps the last sample and key of its channel
+template <typename TChannel>
+struct tKeepsLastSample : std::false_type
+{};
+
+template <typename TSample>
+struct tKeepsLastSample<channel::LastValue<TSample>> : std::true_type
+{};
+
+template <typename TSample>
+struct tKeepsLastSample<channel::StaticLastValue<TSample>> : std::true_type
+{};
+
+template <typename TSample>
+struct tKeepsLastSample<channel::Dense<TSample>> : std::true_type
+{};
+
+}
+
+//! Data fusion in which stale channels expire
+/*! Each channel holds the latest sample, key and timestamp. The wrapped
+ *  TFusion object (e.g. tStaticAverage or tMaximumKey) only has the
+ *  channels that have not expired, in no particular order. Every update
+ *  is forwarded to it right away. A returning channel is appended to it.
+ *  An expired channel is replaced by the last one, which is moved into
+ *  its place. The fused value is valid while at least
+ *  SetMinimumNumberOfChannels channels (default: 1) are fresh.
+ *
+ *  A moved channel is rebuilt from its latest sample and key. Channel
+ *  policies that combine several samples (e.g. channel::Average or
+ *  channel::Median) would lose the others, so TFusion must use
+ *  channel::LastValue, channel::StaticLastValue or channel::Dense.
+ *
+ *  TFusion must support changing its number of channels, so fusers with a
+ *  fixed number of channels can not be used. Incremental fusers
+ *  recalculate their sum whenever the set of fresh channels changes.
+ */
+template <typename TFusion>
+class tExpiringDataFusion
+{
+
+  static_assert(internal::tKeepsLastSample<typename TFusion::tChannels::value_type>::value, "Moved channels are rebuilt from their last sample, so TFusion must use a channel policy that only keeps the last sample");
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename TFusion::tSample tSample;
+  typedef std::chrono::steady_clock tClock;
+  typedef tClock::time_point tTimestamp;
+
+  //! The wrapped fusion object and all channels allocate from resource
+  explicit tExpiringDataFusion(size_t number_of_channels = 0, tClock::duration maximum_age = std::chrono::seconds(1), tMemoryResource &resource = GetDefaultMemoryResource())
+    : fusion(resource),
+      channels(tAllocator<tChannel>(resource)),
+      heap(tAllocator<size_t>(resource)),
+      fused_channels(tAllocator<size_t>(resource)),
+      maximum_age(maximum_age),
+      minimum_number_of_channels(1)
+  {
+    this->SetNumberOfChannels(number_of_channels);
+  }
+
+  inline size_t NumberOfChannels() const
+  {
+    return this->channels.size();
+  }
+
+  //! Also reserves the channels of the wrapped fusion object, so later changes of the fresh channels do not allocate
+  void SetNumberOfChannels(size_t number_of_channels)
+  {
+    this->channels.assign(number_of_channels, tChannel());
+    this->heap.clear();
+    this->heap.reserve(number_of_channels);
+    this->fused_channels.clear();
+    this->fused_channels.reserve(number_of_channels);
+    this->fusion.SetNumberOfChannels(number_of_channels);
+    this->fusion.SetNumberOfChannels(0);
+  }
+
+  inline void SetMaximumAge(tClock::duration maximum_age)
+  {
+    this->maximum_age = maximum_age;
+  }
+
+  inline void SetMinimumNumberOfChannels(size_t minimum_number_of_channels)
+  {
+    this->minimum_number_of_channels = minimum_number_of_channels;
+  }
+
+  inline void UpdateChannel(size_t channel, const tSample &sample, double key = 1)
+  {
+    this->UpdateChannel(channel, sample, key, tClock::now());
+  }
+
+  //! Updates a channel with a sample that was measured at timestamp
+  void UpdateChannel(size_t channel, const tSample &sample, double key, tTimestamp timestamp)
+  {
+    if (channel >= this->channels.size())
+    {
+      std::stringstream stream;
+      stream << "Channel " << channel << " does not exist in fusion object with " << this->channels.size() << " channel" << (this->channels.size() == 1 ? "" : "s") << "!";
+      throw std::runtime_error(stream.str());
+    }
+    tChannel &updated_channel = this->channels[channel];
+    updated_channel.sample = sample;
+    updated_channel.key = key;
+    updated_channel.timestamp = timestamp;
+    if (updated_channel.heap_position == cNONE)
+    {
+      updated_channel.heap_position = this->heap.size();
+      this->heap.push_back(channel);
+      this->SiftUp(updated_channel.heap_position);
+      updated_channel.fused_channel = this->fused_channels.size();
+      this->fused_channels.push_back(channel);
+      this->fusion.SetNumberOfChannels(this->fused_channels.size());
+      this->fusion.UpdateChannel(updated_channel.fused_channel, sample, key);
+      return;
+    }
+    this->SiftDown(updated_channel.heap_position);
+    this->SiftUp(updated_channel.heap_position);
+    this->fusion.UpdateChannel(updated_channel.fused_channel, sample, key);
+  }
+
+  //! The number of channels that are not expired at time now
+  inline size_t NumberOfValidChannels(tTimestamp now = tClock::now())
+  {
+    this->Expire(now);
+    return this->heap.size();
+  }
+
+  const bool IsValid(tTimestamp now = tClock::now())
+  {
+    this->Expire(now);
+    if (this->heap.empty() || this->heap.size() < this->minimum_number_of_channels)
+    {
+      return false;
+    }
+    return this->fusion.IsValid();
+  }
+
+  //! The fused value of all channels that are not expired at time now
+  const tSample &FusedValue(tTimestamp now = tClock::now())
+  {
+    if (!this->IsValid(now))
+    {
+      throw std::runtime_error("Fused value not available with invalid state!");
+    }
+    return this->fusion.FusedValue();
+  }
+
+  void ClearChannels()
+  {
+    for (auto it = this->heap.begin(); it != this->heap.end(); ++it)
+    {
+      this->channels[*it].heap_position = cNONE;
+    }
+    this->heap.clear();
+    this->fused_channels.clear();
+    this->fusion.SetNumberOfChannels(0);
+  }
+
+  void ResetState()
+  {
+    this->ClearChannels();
+    this->fusion.ResetState();
+  }
+
+  //! The wrapped fusion object, e.g. for configuration
+  inline TFusion &Fusion()
+  {
+    return this->fusion;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static const size_t cNONE = static_cast<size_t>(-1);
+
+  struct tChannel
+  {
+    tSample sample;
+    double key;
+    tTimestamp timestamp;
+    size_t heap_position;
+    size_t fused_channel;
+
+    tChannel()
+      : key(0),
+        heap_position(cNONE),
+        fused_channel(0)
+    {}
+  };
+
+  TFusion fusion;
+  std::vector<tChannel, tAllocator<tChannel>> channels;
+  std::vector<size_t, tAllocator<size_t>> heap;
+  std::vector<size_t, tAllocator<size_t>> fused_channels;   // the channel of each channel of the wrapped fusion object
+  tClock::duration maximum_age;
+  size_t minimum_number_of_channels;
+
+  inline bool IsOlder(size_t a, size_t b) const
+  {
+    return this->channels[this->heap[a]].timestamp < this->channels[this->heap[b]].timestamp;
+  }
+
+  inline void Swap(size_t a, size_t b)
+  {
+    std::swap(this->heap[a], this->heap[b]);
+    this->channels[this->heap[a]].heap_position = a;
+    this->channels[this->heap[b]].heap_position = b;
+  }
+
+  void SiftUp(size_t position)
+  {
+    while (position > 0 && this->IsOlder(position, (position - 1) / 2))
+    {
+      this->Swap(position, (position - 1) / 2);
+      position = (position - 1) / 2;
+    }
+  }
+
+  void SiftDown(size_t position)
+  {
+    for (;;)
+    {
+      size_t oldest = position;
+      for (size_t child = 2 * position + 1; child <= 2 * position + 2 && child < this->heap.size(); ++child)
+      {
+        if (this->IsOlder(child, oldest))
+        {
+          oldest = child;
+        }
+      }
+      if (oldest == position)
+      {
+        return;
+      }
+      this->Swap(position, oldest);
+      position = oldest;
+    }
+  }
+
+  void Expire(tTimestamp now)
+  {
+    while (!this->heap.empty() && now - this->channels[this->heap.front()].timestamp > this->maximum_age)
+    {
+      tChannel &expired_channel = this->channels[this->heap.front()];
+      expired_channel.heap_position = cNONE;
+      this->heap.front() = this->heap.back();
+      this->heap.pop_back();
+      if (!this->heap.empty())
+      {
+        this->channels[this->heap.front()].heap_position = 0;
+        this->SiftDown(0);
+      }
+      this->RemoveFusedChannel(expired_channel.fused_channel);
+    }
+  }
+
+  //! Moves the last channel of the wrapped fusion object to fused_channel and drops the last one
+  void RemoveFusedChannel(size_t fused_channel)
+  {
+    size_t last_channel = this->fused_channels.back();
+    if (fused_channel != this->fused_channels.size() - 1)
+    {
+      tChannel &moved_channel = this->channels[last_channel];
+      moved_channel.fused_channel = fused_channel;
+      this->fused_channels[fused_channel] = last_channel;
+      this->fusion.ClearChannel(fused_channel);
+      this->fusion.UpdateChannel(fused_channel, moved_channel.sample, moved_channel.key);
+    }
+    this->fused_channels.pop_back();
+    this->fusion.SetNumberOfChannels(this->fused_channels.size());
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
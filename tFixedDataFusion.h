@@ -0,0 +1,89 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tFixedDataFusion.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tFixedDataFusion
+ *
+ * \b tFixedDataFusion
+ *
+ * Base for fusion objects whose number of channels is known at compile
+ * time. The channels are stored in a std::array inside the fusion object,
+ * so these objects never allocate memory and do not need a call to
+ * SetNumberOfChannels. All loops over the channels have constant bounds.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tFixedDataFusion_h__
+#define __rrlib__data_fusion__tFixedDataFusion_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <array>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tStaticDataFusion.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Statically dispatched base class for data fusion with a fixed number of channels
+/*! The fixed fusers (e.g. tFixedAverage) are derived from this base.
+ *  SetNumberOfChannels is not available for these objects.
+ */
+template <
+typename TFusion,
+         typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+using tFixedDataFusion = tStaticDataFusion<TFusion, TSample, TChannel, std::array<TChannel<TSample>, Tnumber_of_channels>>;
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
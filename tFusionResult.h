@@ -0,0 +1,143 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tFusionResult.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tFusionResult
+ *
+ * \b tFusionResult
+ *
+ * Status codes and results of the noexcept Try* methods of fusion objects
+ * and channel policies. They report the same errors as the exceptions of
+ * the throwing methods, for threads that must not throw.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tFusionResult_h__
+#define __rrlib__data_fusion__tFusionResult_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+//! Moves error handling out of line and marks it as rarely executed
+#if defined(__GNUC__)
+#define RRLIB_DATA_FUSION_COLD __attribute__((cold, noinline))
+#define RRLIB_DATA_FUSION_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+#define RRLIB_DATA_FUSION_COLD
+#define RRLIB_DATA_FUSION_UNLIKELY(condition) (condition)
+#endif
+
+enum class tFusionStatus
+{
+  OK,                     //!< The operation succeeded
+  CHANNEL_OUT_OF_RANGE,   //!< The channel does not exist in the fusion object
+  NO_CHANNELS,            //!< The fusion object has no channels
+  INVALID_STATE,          //!< Not all channels are valid or the fuser is not ready
+  INVALID_CHANNEL,        //!< The channel does not contain a sample
+  OUT_OF_MEMORY           //!< A channel policy or the fuser could not allocate memory
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Either a value or the status that explains why there is none
+template <typename TValue>
+class tFusionResult
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tFusionResult(tFusionStatus status) noexcept
+    : value(),
+      status(status)
+  {}
+
+  tFusionResult(const TValue &value) noexcept
+    : value(value),
+      status(tFusionStatus::OK)
+  {}
+
+  inline explicit operator bool() const noexcept
+  {
+    return this->status == tFusionStatus::OK;
+  }
+
+  inline tFusionStatus Status() const noexcept
+  {
+    return this->status;
+  }
+
+  //! Only meaningful if the result is OK
+  inline const TValue &Value() const noexcept
+  {
+    return this->value;
+  }
+
+  inline const TValue &ValueOr(const TValue &fallback) const noexcept
+  {
+    return this->status == tFusionStatus::OK ? this->value : fallback;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  TValue value;
+  tFusionStatus status;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -0,0 +1,248 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tIncrementalAverage.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tIncrementalAverage
+ *
+ * \b tIncrementalAverage
+ *
+ * Average of all channels that is maintained incrementally: each update
+ * of a channel replaces the old contribution of this channel in a
+ * running sum, so the fused value is available in constant time.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tIncrementalAverage_h__
+#define __rrlib__data_fusion__tIncrementalAverage_h__
+
+#include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tAccumulator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Implementation shared by tIncrementalAverage and tStaticIncrementalAverage
+template <
+typename TSample,
+         template <typename> class TChannel,
+         typename TBase
+         >
+class tIncrementalAverage : public TBase
+{
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tIncrementalAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource),
+      contributions(ConstructWithResource<typename tChannelBuffer<typename TBase::tChannels, TSample>::type>(resource)),
+      renormalization_interval(cDEFAULT_RENORMALIZATION_INTERVAL),
+      number_of_updates(0),
+      renormalization_required(true)
+  {}
+
+  /*! Sets the number of updates after which the running sum is
+   *  recalculated from scratch to get rid of accumulated rounding errors.
+   *  The interval is never shorter than the number of channels, so the
+   *  recalculation costs constant time per update on average.
+   */
+  inline void SetRenormalizationInterval(size_t number_of_updates)
+  {
+    this->renormalization_interval = number_of_updates;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static const size_t cDEFAULT_RENORMALIZATION_INTERVAL = 1000;
+
+  typename tChannelBuffer<typename TBase::tChannels, TSample>::type contributions;
+  tAccumulator<TSample> accumulator;
+  size_t renormalization_interval;
+  size_t number_of_updates;
+  bool renormalization_required;
+
+  const char *GetLogDescription() const
+  {
+    return "tIncrementalAverage";
+  }
+
+  const bool HasValidState() const
+  {
+    return true;
+  }
+
+  void UpdateChannelImplementation(const typename TBase::tChannels &channels, size_t channel)
+  {
+    if (this->renormalization_required || this->contributions.size() != channels.size() || !channels[channel].IsValid())
+    {
+      this->renormalization_required = true;
+      return;
+    }
+    this->accumulator.Remove(this->contributions[channel]);
+    this->contributions[channel] = channels[channel].GetSample();
+    this->accumulator.Add(this->contributions[channel]);
+    this->number_of_updates++;
+  }
+
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
+  {
+    if (this->renormalization_required || this->contributions.size() != channels.size() || this->number_of_updates >= std::max(this->renormalization_interval, channels.size()))
+    {
+      this->Renormalize(channels);
+    }
+    return this->accumulator.Result(1.0 / channels.size());
+  }
+
+  void Renormalize(const typename TBase::tChannels &channels)
+  {
+    tChannelBuffer<typename TBase::tChannels, TSample>::Resize(this->contributions, channels.size());
+    this->accumulator.Clear();
+    auto contribution = this->contributions.begin();
+    for (auto it = channels.begin(); it != channels.end(); ++it, ++contribution)
+    {
+      *contribution = it->GetSample();
+      this->accumulator.Add(*contribution);
+    }
+    this->number_of_updates = 0;
+    this->renormalization_required = false;
+  }
+
+  void ResetStateImplementation()
+  {
+    this->renormalization_required = true;
+  }
+
+  void EnterNextTimestepImplementation()
+  {}
+
+};
+
+}
+
+//! Average of all channels with constant-time updates
+/*! The running sum is updated whenever a channel changes, so after a
+ *  single UpdateChannel the fused value is available without visiting
+ *  all channels again.
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tIncrementalAverage : public internal::tIncrementalAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tIncrementalAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tIncrementalAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Statically dispatched variant of tIncrementalAverage
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticIncrementalAverage : public internal::tIncrementalAverage<TSample, TChannel, tStaticDataFusion<tStaticIncrementalAverage<TSample, TChannel>, TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tStaticIncrementalAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tIncrementalAverage<TSample, TChannel, tStaticDataFusion<tStaticIncrementalAverage<TSample, TChannel>, TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Variant of tStaticIncrementalAverage with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedIncrementalAverage : public internal::tIncrementalAverage<TSample, TChannel, tFixedDataFusion<tFixedIncrementalAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tFixedIncrementalAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tIncrementalAverage<TSample, TChannel, tFixedDataFusion<tFixedIncrementalAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
+  {}
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -0,0 +1,274 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tIncrementalWeightedAverage.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tIncrementalWeightedAverage
+ *
+ * \b tIncrementalWeightedAverage
+ *
+ * Weighted average of all channels that is maintained incrementally,
+ * using the keys of the channels as weights like tWeightedAverage.
+ * Each update of a channel replaces the old contribution of this
+ * channel in running sums, so the fused value is available in constant
+ * time.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tIncrementalWeightedAverage_h__
+#define __rrlib__data_fusion__tIncrementalWeightedAverage_h__
+
+#include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <utility>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/tAccumulator.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+namespace internal
+{
+
+//! Implementation shared by tIncrementalWeightedAverage and tStaticIncrementalWeightedAverage
+template <
+typename TSample,
+         template <typename> class TChannel,
+         typename TBase
+         >
+class tIncrementalWeightedAverage : public TBase
+{
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tIncrementalWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource),
+      contributions(ConstructWithResource<typename tChannelBuffer<typename TBase::tChannels, std::pair<TSample, double>>::type>(resource)),
+      accumulated_keys(0),
+      number_of_nonzero_keys(0),
+      renormalization_interval(cDEFAULT_RENORMALIZATION_INTERVAL),
+      number_of_updates(0),
+      renormalization_required(true)
+  {}
+
+  //! Sets the number of updates after which the running sums are recalculated (see tIncrementalAverage)
+  inline void SetRenormalizationInterval(size_t number_of_updates)
+  {
+    this->renormalization_interval = number_of_updates;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  static const size_t cDEFAULT_RENORMALIZATION_INTERVAL = 1000;
+
+  typename tChannelBuffer<typename TBase::tChannels, std::pair<TSample, double>>::type contributions;
+  tAccumulator<TSample> weighted_accumulator;
+  tAccumulator<TSample> accumulator;
+  double accumulated_keys;
+  size_t number_of_nonzero_keys;
+  size_t renormalization_interval;
+  size_t number_of_updates;
+  bool renormalization_required;
+
+  const char *GetLogDescription() const
+  {
+    return "tIncrementalWeightedAverage";
+  }
+
+  const bool HasValidState() const
+  {
+    return true;
+  }
+
+  void UpdateChannelImplementation(const typename TBase::tChannels &channels, size_t channel)
+  {
+    if (this->renormalization_required || this->contributions.size() != channels.size() || !channels[channel].IsValid())
+    {
+      this->renormalization_required = true;
+      return;
+    }
+    this->RemoveContribution(this->contributions[channel]);
+    this->contributions[channel] = std::make_pair(channels[channel].GetSample(), channels[channel].GetKey());
+    this->AddContribution(this->contributions[channel]);
+    this->number_of_updates++;
+  }
+
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
+  {
+    if (this->renormalization_required || this->contributions.size() != channels.size() || this->number_of_updates >= std::max(this->renormalization_interval, channels.size()))
+    {
+      this->Renormalize(channels);
+    }
+    if (this->number_of_nonzero_keys == 0)
+    {
+      return this->accumulator.Result(1.0 / channels.size());
+    }
+    return this->weighted_accumulator.Result(1.0 / this->accumulated_keys);
+  }
+
+  void Renormalize(const typename TBase::tChannels &channels)
+  {
+    tChannelBuffer<typename TBase::tChannels, std::pair<TSample, double>>::Resize(this->contributions, channels.size());
+    this->weighted_accumulator.Clear();
+    this->accumulator.Clear();
+    this->accumulated_keys = 0;
+    this->number_of_nonzero_keys = 0;
+    auto contribution = this->contributions.begin();
+    for (auto it = channels.begin(); it != channels.end(); ++it, ++contribution)
+    {
+      *contribution = std::make_pair(it->GetSample(), it->GetKey());
+      this->AddContribution(*contribution);
+    }
+    this->number_of_updates = 0;
+    this->renormalization_required = false;
+  }
+
+  inline void AddContribution(const std::pair<TSample, double> &contribution)
+  {
+    this->weighted_accumulator.Add(contribution.first, contribution.second);
+    this->accumulator.Add(contribution.first);
+    this->accumulated_keys += contribution.second;
+    this->number_of_nonzero_keys += contribution.second != 0.0;
+  }
+
+  inline void RemoveContribution(const std::pair<TSample, double> &contribution)
+  {
+    this->weighted_accumulator.Remove(contribution.first, contribution.second);
+    this->accumulator.Remove(contribution.first);
+    this->accumulated_keys -= contribution.second;
+    this->number_of_nonzero_keys -= contribution.second != 0.0;
+  }
+
+  void ResetStateImplementation()
+  {
+    this->renormalization_required = true;
+  }
+
+  void EnterNextTimestepImplementation()
+  {}
+
+};
+
+}
+
+//! Weighted average of all channels with constant-time updates
+/*! As in tWeightedAverage, all channels are weighted equally if all keys
+ *  are zero.
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tIncrementalWeightedAverage : public internal::tIncrementalWeightedAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tIncrementalWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tIncrementalWeightedAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Statically dispatched variant of tIncrementalWeightedAverage
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticIncrementalWeightedAverage : public internal::tIncrementalWeightedAverage<TSample, TChannel, tStaticDataFusion<tStaticIncrementalWeightedAverage<TSample, TChannel>, TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tStaticIncrementalWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tIncrementalWeightedAverage<TSample, TChannel, tStaticDataFusion<tStaticIncrementalWeightedAverage<TSample, TChannel>, TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Variant of tStaticIncrementalWeightedAverage with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedIncrementalWeightedAverage : public internal::tIncrementalWeightedAverage<TSample, TChannel, tFixedDataFusion<tFixedIncrementalWeightedAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tFixedIncrementalWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tIncrementalWeightedAverage<TSample, TChannel, tFixedDataFusion<tFixedIncrementalWeightedAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
+  {}
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
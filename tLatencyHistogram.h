@@ -0,0 +1,264 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tLatencyHistogram.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tLatencyHistogram
+ *
+ * \b tLatencyHistogram
+ *
+ * Fixed-size histogram of latencies with logarithmically growing bucket
+ * sizes, similar to HdrHistogram: every power of two range is split into
+ * eight linear buckets, so percentiles are accurate to 12.5% from one
+ * nanosecond up to about a minute. Recording is lock-free.
+ *
+ * Fusion objects keep histograms of their operations when
+ * RRLIB_DATA_FUSION_LATENCY_HISTOGRAMS is defined.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tLatencyHistogram_h__
+#define __rrlib__data_fusion__tLatencyHistogram_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+#ifdef RRLIB_DATA_FUSION_LATENCY_HISTOGRAMS
+#define RRLIB_DATA_FUSION_MEASURE_LATENCY(histogram) tLatencyHistogram::tMeasurement latency_measurement(this->latency_histograms.histogram)
+#define RRLIB_DATA_FUSION_ATTRIBUTE_LATENCY(histogram) latency_measurement.Attribute(this->latency_histograms.histogram)
+#else
+#define RRLIB_DATA_FUSION_MEASURE_LATENCY(histogram)
+#define RRLIB_DATA_FUSION_ATTRIBUTE_LATENCY(histogram)
+#endif
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Latency histogram with fixed memory and lock-free recording
+class tLatencyHistogram
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  //! Records the time from construction to destruction in a histogram
+  class tMeasurement
+  {
+  public:
+
+    explicit tMeasurement(tLatencyHistogram &histogram)
+      : histogram(&histogram),
+        start(std::chrono::steady_clock::now())
+    {}
+
+    ~tMeasurement()
+    {
+      this->histogram->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count());
+    }
+
+    //! Records the measurement in histogram instead
+    inline void Attribute(tLatencyHistogram &histogram)
+    {
+      this->histogram = &histogram;
+    }
+
+  private:
+
+    tLatencyHistogram *histogram;
+    std::chrono::steady_clock::time_point start;
+
+  };
+
+  tLatencyHistogram()
+  {
+    this->Reset();
+  }
+
+  tLatencyHistogram(const tLatencyHistogram &other)
+  {
+    *this = other;
+  }
+
+  tLatencyHistogram &operator=(const tLatencyHistogram &other)
+  {
+    for (size_t i = 0; i < cNUMBER_OF_BUCKETS; ++i)
+    {
+      this->buckets[i].store(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    this->maximum.store(other.maximum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  inline void Record(uint64_t nanoseconds)
+  {
+    this->buckets[BucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t maximum = this->maximum.load(std::memory_order_relaxed);
+    while (nanoseconds > maximum && !this->maximum.compare_exchange_weak(maximum, nanoseconds, std::memory_order_relaxed))
+    {}
+  }
+
+  uint64_t Count() const
+  {
+    uint64_t count = 0;
+    for (size_t i = 0; i < cNUMBER_OF_BUCKETS; ++i)
+    {
+      count += this->buckets[i].load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  inline uint64_t Maximum() const
+  {
+    return this->maximum.load(std::memory_order_relaxed);
+  }
+
+  /*! The latency in nanoseconds below which the given fraction of the
+   *  recorded latencies lie (e.g. 0.99 for p99), as upper bound of the
+   *  bucket that contains it. 0 if nothing was recorded.
+   */
+  uint64_t Percentile(double fraction) const
+  {
+    uint64_t count = this->Count();
+    if (count == 0)
+    {
+      return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(fraction * count);
+    rank = rank < 1 ? 1 : (rank > count ? count : rank);
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < cNUMBER_OF_BUCKETS; ++i)
+    {
+      accumulated += this->buckets[i].load(std::memory_order_relaxed);
+      if (accumulated >= rank && i + 1 < cNUMBER_OF_BUCKETS)
+      {
+        uint64_t upper_bound = BucketLowerBound(i + 1) - 1;
+        return upper_bound < this->Maximum() ? upper_bound : this->Maximum();
+      }
+    }
+    return this->Maximum();
+  }
+
+  void Reset()
+  {
+    for (size_t i = 0; i < cNUMBER_OF_BUCKETS; ++i)
+    {
+      this->buckets[i].store(0, std::memory_order_relaxed);
+    }
+    this->maximum.store(0, std::memory_order_relaxed);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum
+  {
+    cSUB_BUCKET_BITS = 3,
+    cSUB_BUCKETS = 1 << cSUB_BUCKET_BITS,
+    cMAXIMUM_BITS = 36,
+    cNUMBER_OF_BUCKETS = (cMAXIMUM_BITS - cSUB_BUCKET_BITS + 1) * cSUB_BUCKETS
+  };
+
+  std::atomic<uint64_t> buckets[cNUMBER_OF_BUCKETS];
+  std::atomic<uint64_t> maximum;
+
+  //! Values below cSUB_BUCKETS have their own buckets, larger ones share a bucket with values of the same magnitude
+  static inline size_t BucketIndex(uint64_t value)
+  {
+    if (value < cSUB_BUCKETS)
+    {
+      return value;
+    }
+    size_t magnitude = 63 - __builtin_clzll(value);
+    if (magnitude >= cMAXIMUM_BITS)
+    {
+      return cNUMBER_OF_BUCKETS - 1;
+    }
+    size_t shift = magnitude - cSUB_BUCKET_BITS;
+    return (shift + 1) * cSUB_BUCKETS + ((value >> shift) - cSUB_BUCKETS);
+  }
+
+  static inline uint64_t BucketLowerBound(size_t index)
+  {
+    if (index < cSUB_BUCKETS)
+    {
+      return index;
+    }
+    size_t shift = index / cSUB_BUCKETS - 1;
+    return static_cast<uint64_t>(cSUB_BUCKETS + index % cSUB_BUCKETS) << shift;
+  }
+
+};
+
+//! Latency histograms of the operations of one fusion object
+struct tLatencyHistograms
+{
+  tLatencyHistogram update_channel;
+  tLatencyHistogram fused_value_cache_hit;
+  tLatencyHistogram fused_value_recalculation;
+  tLatencyHistogram enter_next_timestep;
+
+  void Reset()
+  {
+    this->update_channel.Reset();
+    this->fused_value_cache_hit.Reset();
+    this->fused_value_recalculation.Reset();
+    this->enter_next_timestep.Reset();
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -37,6 +37,7 @@
 #define __rrlib__data_fusion__tMaximumKey_h__
 
 #include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
@@ -46,6 +47,8 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
+#include "rrlib/data_fusion/simd.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -66,53 +69,125 @@ namespace data_fusion
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of tMaximumKey
-/*! A more detailed description of tMaximumKey, which
- *  Tobias Foehst hasn't done yet !!
- */
+namespace internal
+{
+
+//! Implementation shared by tMaximumKey and tStaticMaximumKey
 template <
 typename TSample,
-         template <typename> class TChannel = channel::LastValue
+         template <typename> class TChannel,
+         typename TBase
          >
-class tMaximumKey : public tDataFusion<TSample, TChannel>
+class tMaximumKey : public TBase
 {
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMaximumKey(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource)
+  {}
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  virtual const char *GetLogDescription() const
+  const char *GetLogDescription() const
   {
     return "tMaximumKey";
   }
 
-  virtual const bool HasValidState() const
+  const bool HasValidState() const
   {
     return true;
   }
 
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
   {
-    auto channel = channels.begin();
-    TSample result = channel->GetSample();
-    double maximum_key = channel->GetKey();
-    while (channel != channels.end())
-    {
-      if (channel->GetKey() > maximum_key)
-      {
-        result = channel->GetSample();
-        maximum_key = channel->GetKey();
-      }
-      ++channel;
-    }
-    return result;
+    return this->CalculateFusedValue(channels, simd::tHasKernels<typename TBase::tChannels>());
   }
 
-  virtual void ResetStateImplementation()
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::true_type)
+  {
+    return channels.Sample(simd::ArgMax(channels.Keys(), channels.size()));
+  }
+
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::false_type)
+  {
+    return kernels::MaximumKey<TSample>(kernels::ChannelSamples(channels.begin()), kernels::ChannelSamples(channels.end()), kernels::ChannelKeys(channels.begin()));
+  }
+
+  void ResetStateImplementation()
+  {}
+
+  void EnterNextTimestepImplementation()
   {}
 
-  virtual void EnterNextTimestepImplementation()
+};
+
+}
+
+//! Short description of tMaximumKey
+/*! A more detailed description of tMaximumKey, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tMaximumKey : public internal::tMaximumKey<TSample, TChannel, tDataFusion<TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMaximumKey(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMaximumKey<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Statically dispatched variant of tMaximumKey
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticMaximumKey : public internal::tMaximumKey<TSample, TChannel, tStaticDataFusion<tStaticMaximumKey<TSample, TChannel>, TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tStaticMaximumKey(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMaximumKey<TSample, TChannel, tStaticDataFusion<tStaticMaximumKey<TSample, TChannel>, TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Variant of tStaticMaximumKey with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedMaximumKey : public internal::tMaximumKey<TSample, TChannel, tFixedDataFusion<tFixedMaximumKey<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tFixedMaximumKey(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMaximumKey<TSample, TChannel, tFixedDataFusion<tFixedMaximumKey<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
   {}
 
 };
@@ -37,15 +37,18 @@
 #define __rrlib__data_fusion__tMedianKeyVoter_h__
 
 #include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include <list>
+#include <functional>
+#include <utility>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -66,54 +69,131 @@ namespace data_fusion
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of tMedianKeyVoter
-/*! A more detailed description of tMedianKeyVoter, which
- *  Tobias Foehst hasn't done yet !!
- */
+namespace internal
+{
+
+//! Implementation shared by tMedianKeyVoter and tStaticMedianKeyVoter
 template <
 typename TSample,
-         template <typename> class TChannel = channel::LastValue
+         template <typename> class TChannel,
+         typename TBase
          >
-class tMedianKeyVoter : public tDataFusion<TSample, TChannel>
+class tMedianKeyVoter : public TBase
 {
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMedianKeyVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource),
+      selection_algorithm(tSelectionAlgorithm::INTROSELECT),
+      keys(ConstructWithResource<typename tChannelBuffer<typename TBase::tChannels, kernels::tIndexedKey>::type>(this->TimestepResource()))
+  {}
+
+  /*! Use tSelectionAlgorithm::MEDIAN_OF_MEDIANS for a linear worst-case
+   *  bound. 3, 5, 7 and 9 channels always use a selection network.
+   */
+  inline void SetSelectionAlgorithm(tSelectionAlgorithm selection_algorithm)
+  {
+    this->selection_algorithm = selection_algorithm;
+  }
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  virtual const char *GetLogDescription() const
+  tSelectionAlgorithm selection_algorithm;
+  typename tChannelBuffer<typename TBase::tChannels, kernels::tIndexedKey>::type keys;   // scratch of the current timestep
+
+  const char *GetLogDescription() const
   {
     return "tMedianKeyVoter";
   }
 
-  virtual const bool HasValidState() const
+  const bool HasValidState() const
   {
     return true;
   }
 
-  static bool CompareSamples(const std::pair<TSample, double> &a, const std::pair<TSample, double> &b)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
   {
-    return a.second < b.second;
+    tChannelBuffer<typename TBase::tChannels, kernels::tIndexedKey>::Resize(this->keys, channels.size());
+    return channels[kernels::MedianKeyIndex(kernels::ChannelKeys(channels.begin()), kernels::ChannelKeys(channels.end()), this->keys.begin(), this->selection_algorithm)].GetSample();
   }
 
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels)
+  void ResetStateImplementation()
+  {}
+
+  void EnterNextTimestepImplementation()
   {
-    std::list<std::pair<TSample, double>> samples;
-    for (typename std::vector<TChannel<TSample>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      samples.push_back(std::make_pair(it->GetSample(), it->GetKey()));
-    }
-    samples.sort(CompareSamples);
-    typename std::list<std::pair<TSample, double>>::iterator it = samples.begin();
-    std::advance(it, std::trunc(samples.size() / 2.0));
-    return it->first;
+    tChannelBuffer<typename TBase::tChannels, kernels::tIndexedKey>::Release(this->keys);
   }
 
-  virtual void ResetStateImplementation()
+};
+
+}
+
+//! Short description of tMedianKeyVoter
+/*! A more detailed description of tMedianKeyVoter, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tMedianKeyVoter : public internal::tMedianKeyVoter<TSample, TChannel, tDataFusion<TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMedianKeyVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMedianKeyVoter<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Statically dispatched variant of tMedianKeyVoter
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticMedianKeyVoter : public internal::tMedianKeyVoter<TSample, TChannel, tStaticDataFusion<tStaticMedianKeyVoter<TSample, TChannel>, TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tStaticMedianKeyVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMedianKeyVoter<TSample, TChannel, tStaticDataFusion<tStaticMedianKeyVoter<TSample, TChannel>, TSample, TChannel>>(resource)
   {}
 
-  virtual void EnterNextTimestepImplementation()
+};
+
+//! Variant of tStaticMedianKeyVoter with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedMedianKeyVoter : public internal::tMedianKeyVoter<TSample, TChannel, tFixedDataFusion<tFixedMedianKeyVoter<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tFixedMedianKeyVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMedianKeyVoter<TSample, TChannel, tFixedDataFusion<tFixedMedianKeyVoter<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
   {}
 
 };
@@ -37,15 +37,17 @@
 #define __rrlib__data_fusion__tMedianVoter_h__
 
 #include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include <list>
+#include <functional>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -66,54 +68,131 @@ namespace data_fusion
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of tMedianVoter
-/*! A more detailed description of tMedianVoter, which
- *  Tobias Foehst hasn't done yet !!
- */
+namespace internal
+{
+
+//! Implementation shared by tMedianVoter and tStaticMedianVoter
 template <
 typename TSample,
-         template <typename> class TChannel = channel::LastValue
+         template <typename> class TChannel,
+         typename TBase
          >
-class tMedianVoter : public tDataFusion<TSample, TChannel>
+class tMedianVoter : public TBase
 {
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMedianVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource),
+      selection_algorithm(tSelectionAlgorithm::INTROSELECT),
+      samples(ConstructWithResource<typename tChannelBuffer<typename TBase::tChannels, TSample>::type>(this->TimestepResource()))
+  {}
+
+  /*! Use tSelectionAlgorithm::MEDIAN_OF_MEDIANS for a linear worst-case
+   *  bound. 3, 5, 7 and 9 channels always use a selection network.
+   */
+  inline void SetSelectionAlgorithm(tSelectionAlgorithm selection_algorithm)
+  {
+    this->selection_algorithm = selection_algorithm;
+  }
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  virtual const char *GetLogDescription() const
+  tSelectionAlgorithm selection_algorithm;
+  typename tChannelBuffer<typename TBase::tChannels, TSample>::type samples;   // scratch of the current timestep
+
+  const char *GetLogDescription() const
   {
     return "tMedianVoter";
   }
 
-  virtual const bool HasValidState() const
+  const bool HasValidState() const
   {
     return true;
   }
 
-  static bool CompareSamples(const std::pair<TSample, double> &a, const std::pair<TSample, double> &b)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
   {
-    return a.second < b.second;
+    tChannelBuffer<typename TBase::tChannels, TSample>::Resize(this->samples, channels.size());
+    return kernels::Median<TSample>(kernels::ChannelSamples(channels.begin()), kernels::ChannelSamples(channels.end()), this->samples.begin(), this->selection_algorithm);
   }
 
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels)
+  void ResetStateImplementation()
+  {}
+
+  void EnterNextTimestepImplementation()
   {
-    std::list<TSample> samples;
-    for (typename std::vector<TChannel<TSample>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      samples.push_back(it->GetSample());
-    }
-    samples.sort();
-    typename std::list<TSample>::iterator it = samples.begin();
-    std::advance(it, std::trunc(samples.size() / 2.0));
-    return *it;
+    tChannelBuffer<typename TBase::tChannels, TSample>::Release(this->samples);
   }
 
-  virtual void ResetStateImplementation()
+};
+
+}
+
+//! Short description of tMedianVoter
+/*! A more detailed description of tMedianVoter, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tMedianVoter : public internal::tMedianVoter<TSample, TChannel, tDataFusion<TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tMedianVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMedianVoter<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
+  {}
+
+};
+
+//! Statically dispatched variant of tMedianVoter
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticMedianVoter : public internal::tMedianVoter<TSample, TChannel, tStaticDataFusion<tStaticMedianVoter<TSample, TChannel>, TSample, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tStaticMedianVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMedianVoter<TSample, TChannel, tStaticDataFusion<tStaticMedianVoter<TSample, TChannel>, TSample, TChannel>>(resource)
   {}
 
-  virtual void EnterNextTimestepImplementation()
+};
+
+//! Variant of tStaticMedianVoter with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedMedianVoter : public internal::tMedianVoter<TSample, TChannel, tFixedDataFusion<tFixedMedianVoter<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tFixedMedianVoter(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tMedianVoter<TSample, TChannel, tFixedDataFusion<tFixedMedianVoter<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
   {}
 
 };
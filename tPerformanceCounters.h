@@ -0,0 +1,156 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPerformanceCounters.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tPerformanceCounters
+ *
+ * \b tPerformanceCounters
+ *
+ * Optional per-fuser instrumentation. It is compiled in when
+ * RRLIB_DATA_FUSION_PERFORMANCE_COUNTERS is defined. Otherwise the
+ * counting macros expand to nothing and fusion objects contain no
+ * counters.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tPerformanceCounters_h__
+#define __rrlib__data_fusion__tPerformanceCounters_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+#ifdef RRLIB_DATA_FUSION_PERFORMANCE_COUNTERS
+#define RRLIB_DATA_FUSION_COUNT(counter, value) this->performance_counters.counter.fetch_add(value, std::memory_order_relaxed)
+#define RRLIB_DATA_FUSION_TIME_CALCULATION() tPerformanceCounters::tCalculationTimer calculation_timer(this->performance_counters)
+#else
+#define RRLIB_DATA_FUSION_COUNT(counter, value)
+#define RRLIB_DATA_FUSION_TIME_CALCULATION()
+#endif
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Counters of one fusion object
+/*! The counters are relaxed atomics, so they may be read by a monitoring
+ *  thread while the fusion object is used.
+ */
+struct tPerformanceCounters
+{
+  std::atomic<uint64_t> update_calls;              //!< Calls of the UpdateChannel(s) methods
+  std::atomic<uint64_t> samples;                   //!< Samples added to channels
+  std::atomic<uint64_t> fused_value_calls;         //!< Calls of FusedValue
+  std::atomic<uint64_t> cache_hits;                //!< FusedValue calls answered without recalculation
+  std::atomic<uint64_t> recalculations;            //!< FusedValue calls that called CalculateFusedValue
+  std::atomic<uint64_t> calculation_nanoseconds;   //!< Time spent in CalculateFusedValue
+  std::atomic<uint64_t> exceptions;                //!< Exceptions thrown by the fusion object
+
+  tPerformanceCounters()
+  {
+    this->Reset();
+  }
+
+  tPerformanceCounters(const tPerformanceCounters &other)
+  {
+    *this = other;
+  }
+
+  tPerformanceCounters &operator=(const tPerformanceCounters &other)
+  {
+    this->update_calls.store(other.update_calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->samples.store(other.samples.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->fused_value_calls.store(other.fused_value_calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->cache_hits.store(other.cache_hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->recalculations.store(other.recalculations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->calculation_nanoseconds.store(other.calculation_nanoseconds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    this->exceptions.store(other.exceptions.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  void Reset()
+  {
+    this->update_calls.store(0, std::memory_order_relaxed);
+    this->samples.store(0, std::memory_order_relaxed);
+    this->fused_value_calls.store(0, std::memory_order_relaxed);
+    this->cache_hits.store(0, std::memory_order_relaxed);
+    this->recalculations.store(0, std::memory_order_relaxed);
+    this->calculation_nanoseconds.store(0, std::memory_order_relaxed);
+    this->exceptions.store(0, std::memory_order_relaxed);
+  }
+
+  //! Adds the time until its destruction to calculation_nanoseconds
+  class tCalculationTimer
+  {
+  public:
+
+    explicit tCalculationTimer(tPerformanceCounters &counters)
+      : counters(counters),
+        start(std::chrono::steady_clock::now())
+    {}
+
+    ~tCalculationTimer()
+    {
+      this->counters.calculation_nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count(), std::memory_order_relaxed);
+    }
+
+  private:
+
+    tPerformanceCounters &counters;
+    std::chrono::steady_clock::time_point start;
+
+  };
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -0,0 +1,235 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tQuantileEstimator.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tQuantileEstimator
+ *
+ * \b tQuantileEstimator
+ *
+ * Streaming estimation of a quantile with the P² algorithm (Jain and
+ * Chlamtac, 1985). Five markers track the minimum, the maximum, the
+ * quantile and two points halfway in between. Each new value moves the
+ * markers using piecewise parabolic interpolation, so memory and cost per
+ * value are constant.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tQuantileEstimator_h__
+#define __rrlib__data_fusion__tQuantileEstimator_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Constant-space estimator of the p-quantile of a stream of values
+/*! As long as less than five values were added, the result is exact and
+ *  chosen like in tMedianVoter (the element at position p * n of the
+ *  sorted values). Values must be convertible to and from double.
+ */
+class tQuantileEstimator
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tQuantileEstimator(double p = 0.5)
+    : p(p),
+      count(0)
+  {
+    if (p < 0 || p > 1)
+    {
+      throw std::logic_error("Quantile must be in [0, 1]!");
+    }
+  }
+
+  inline size_t Count() const
+  {
+    return this->count;
+  }
+
+  void Add(double value)
+  {
+    if (this->count < 5)
+    {
+      this->heights[this->count++] = value;
+      if (this->count == 5)
+      {
+        this->Initialize();
+      }
+      return;
+    }
+    this->count++;
+
+    size_t k;
+    if (value < this->heights[0])
+    {
+      this->heights[0] = value;
+      k = 0;
+    }
+    else if (value >= this->heights[4])
+    {
+      this->heights[4] = value;
+      k = 3;
+    }
+    else
+    {
+      k = 0;
+      while (value >= this->heights[k + 1])
+      {
+        k++;
+      }
+    }
+
+    for (size_t i = k + 1; i < 5; ++i)
+    {
+      this->positions[i] += 1;
+    }
+    for (size_t i = 0; i < 5; ++i)
+    {
+      this->desired_positions[i] += this->increments[i];
+    }
+
+    for (size_t i = 1; i < 4; ++i)
+    {
+      double d = this->desired_positions[i] - this->positions[i];
+      if ((d >= 1 && this->positions[i + 1] - this->positions[i] > 1) || (d <= -1 && this->positions[i - 1] - this->positions[i] < -1))
+      {
+        int direction = d < 0 ? -1 : 1;
+        double height = this->Parabolic(i, direction);
+        if (this->heights[i - 1] < height && height < this->heights[i + 1])
+        {
+          this->heights[i] = height;
+        }
+        else
+        {
+          this->heights[i] = this->Linear(i, direction);
+        }
+        this->positions[i] += direction;
+      }
+    }
+  }
+
+  const double Quantile() const
+  {
+    if (this->count == 0)
+    {
+      throw std::logic_error("Quantile of empty stream requested!");
+    }
+    if (this->count < 5)
+    {
+      double sorted[5];
+      std::copy(this->heights, this->heights + this->count, sorted);
+      std::sort(sorted, sorted + this->count);
+      return sorted[std::min(static_cast<size_t>(this->p * this->count), this->count - 1)];
+    }
+    return this->heights[2];
+  }
+
+  inline void Clear()
+  {
+    this->count = 0;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  double p;
+  size_t count;
+  double heights[5];
+  double positions[5];
+  double desired_positions[5];
+  double increments[5];
+
+  void Initialize()
+  {
+    std::sort(this->heights, this->heights + 5);
+    for (size_t i = 0; i < 5; ++i)
+    {
+      this->positions[i] = i;
+    }
+    this->desired_positions[0] = 0;
+    this->desired_positions[1] = 2 * this->p;
+    this->desired_positions[2] = 4 * this->p;
+    this->desired_positions[3] = 2 + 2 * this->p;
+    this->desired_positions[4] = 4;
+    this->increments[0] = 0;
+    this->increments[1] = this->p / 2;
+    this->increments[2] = this->p;
+    this->increments[3] = (1 + this->p) / 2;
+    this->increments[4] = 1;
+  }
+
+  inline double Parabolic(size_t i, int d) const
+  {
+    const double *q = this->heights;
+    const double *n = this->positions;
+    return q[i] + d / (n[i + 1] - n[i - 1]) * ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) + (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+  }
+
+  inline double Linear(size_t i, int d) const
+  {
+    size_t neighbor = d < 0 ? i - 1 : i + 1;
+    return this->heights[i] + d * (this->heights[neighbor] - this->heights[i]) / (this->positions[neighbor] - this->positions[i]);
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
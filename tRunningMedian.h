@@ -0,0 +1,162 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRunningMedian.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tRunningMedian
+ *
+ * \b tRunningMedian
+ *
+ * Median of a growing set of values, maintained in two heaps: a max-heap
+ * with the lower half and a min-heap with the upper half of the values.
+ * Adding a value costs O(log n), the median is available in O(1).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tRunningMedian_h__
+#define __rrlib__data_fusion__tRunningMedian_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Incrementally maintained median
+/*! Median returns the same element as tMedianVoter, i.e. the element at
+ *  position n / 2 of the sorted values. Clear keeps the memory of both
+ *  heaps, so after warming up no further allocations take place.
+ */
+template <typename TValue>
+class tRunningMedian
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  inline size_t Size() const
+  {
+    return this->lower.size() + this->upper.size();
+  }
+
+  void Add(const TValue &value)
+  {
+    if (!this->upper.empty() && value < this->upper.front())
+    {
+      this->lower.push_back(value);
+      std::push_heap(this->lower.begin(), this->lower.end(), std::less<TValue>());
+    }
+    else
+    {
+      this->upper.push_back(value);
+      std::push_heap(this->upper.begin(), this->upper.end(), tGreater());
+    }
+
+    size_t size = this->Size();
+    if (this->lower.size() > size / 2)
+    {
+      std::pop_heap(this->lower.begin(), this->lower.end(), std::less<TValue>());
+      this->upper.push_back(this->lower.back());
+      this->lower.pop_back();
+      std::push_heap(this->upper.begin(), this->upper.end(), tGreater());
+    }
+    else if (this->lower.size() < size / 2)
+    {
+      std::pop_heap(this->upper.begin(), this->upper.end(), tGreater());
+      this->lower.push_back(this->upper.back());
+      this->upper.pop_back();
+      std::push_heap(this->lower.begin(), this->lower.end(), std::less<TValue>());
+    }
+  }
+
+  inline const TValue &Median() const
+  {
+    if (this->upper.empty())
+    {
+      throw std::logic_error("Median of empty set requested!");
+    }
+    return this->upper.front();
+  }
+
+  inline void Clear()
+  {
+    this->lower.clear();
+    this->upper.clear();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  //! Like std::greater, but only needs operator< of TValue (e.g. poses)
+  struct tGreater
+  {
+    inline bool operator()(const TValue &a, const TValue &b) const
+    {
+      return b < a;
+    }
+  };
+
+  std::vector<TValue, tAllocator<TValue>> lower;
+  std::vector<TValue, tAllocator<TValue>> upper;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
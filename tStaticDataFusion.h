@@ -0,0 +1,405 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tStaticDataFusion.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tStaticDataFusion
+ *
+ * \b tStaticDataFusion
+ *
+ * Statically dispatched (CRTP) base for data fusion objects. It provides
+ * the complete public interface of tDataFusion, but calls the fusion
+ * specific methods of TFusion without virtual dispatch. That way the
+ * compiler can inline channel access into the fusion loops.
+ *
+ * tDataFusion itself is derived from this class and forwards the calls
+ * to its virtual methods, so both families share one implementation.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tStaticDataFusion_h__
+#define __rrlib__data_fusion__tStaticDataFusion_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <array>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/memory_resource.h"
+#include "rrlib/data_fusion/tFusionResult.h"
+#include "rrlib/data_fusion/tPerformanceCounters.h"
+#include "rrlib/data_fusion/tLatencyHistogram.h"
+#include "rrlib/data_fusion/tracing.h"
+#include "rrlib/data_fusion/policies/channel/LastValue.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+template <typename TSample>
+class tChannelBank;
+
+//! Storage type of the channels of a fusion object
+/*! Channel policies that do not use one object per channel (e.g. Dense)
+ *  specialize this trait. The default storage allocates from the default
+ *  memory resource at construction of the fusion object (see
+ *  memory_resource.h).
+ */
+template <typename TSample, template <typename> class TChannel>
+struct tChannelStorage
+{
+  typedef std::vector<TChannel<TSample>, tAllocator<TChannel<TSample>>> type;
+};
+
+//! Scratch buffer with one element per channel for a channel storage type
+/*! Fusers use it to rearrange channel data without allocating memory in
+ *  every fusion step. With fixed channel storage the buffer is fixed, too.
+ *  Release frees the memory of a buffer that was allocated from the
+ *  timestep resource of a fuser.
+ */
+template <typename TStorage, typename TElement>
+struct tChannelBuffer
+{
+  typedef std::vector<TElement, tAllocator<TElement>> type;
+
+  static inline void Resize(type &buffer, size_t size)
+  {
+    buffer.resize(size);
+  }
+
+  static inline void Release(type &buffer)
+  {
+    type(buffer.get_allocator()).swap(buffer);
+  }
+};
+
+template <typename TChannel, size_t Tnumber_of_channels, typename TElement>
+struct tChannelBuffer<std::array<TChannel, Tnumber_of_channels>, TElement>
+{
+  typedef std::array<TElement, Tnumber_of_channels> type;
+
+  static inline void Resize(type &, size_t)
+  {}
+
+  static inline void Release(type &)
+  {}
+};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Statically dispatched base class for data fusion
+/*! TFusion is the most derived fusion class. It has to provide the
+ *  methods GetLogDescription, HasValidState, CalculateFusedValue,
+ *  ResetStateImplementation and EnterNextTimestepImplementation with
+ *  the same signatures as the pure virtual methods of tDataFusion.
+ *  They may be private if this class is declared as friend.
+ *
+ *  TFusion may additionally provide UpdateChannelImplementation, which is
+ *  called after a sample was added to a channel. This allows incremental
+ *  fusion without recalculating the fused value from all channels.
+ *
+ *  TStorage is the container of the channels. It defaults to the storage
+ *  selected by the channel policy (see tChannelStorage).
+ *
+ *  The channels and all other memory kept across timesteps are allocated
+ *  from the resource given to the constructor (MemoryResource). Scratch
+ *  buffers that are only needed within a timestep should be allocated
+ *  from TimestepResource, an arena on top of that resource. The fuser
+ *  drops these buffers in EnterNextTimestepImplementation, after which
+ *  EnterNextTimestep releases the arena. As the arena keeps its largest
+ *  chunk, a timestep like the previous one does not allocate.
+ */
+template <
+typename TFusion,
+         typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue,
+         typename TStorage = typename tChannelStorage<TSample, TChannel>::type
+         >
+class tStaticDataFusion
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef TSample tSample;
+  typedef TStorage tChannels;
+
+  inline size_t NumberOfChannels() const
+  {
+    return this->channels.size();
+  }
+
+  void SetNumberOfChannels(size_t number_of_channels);
+
+  inline size_t NumberOfValidChannels() const
+  {
+    return this->number_of_valid_channels;
+  }
+
+  void UpdateChannel(size_t channel, const tSample &sample, double key = 1);
+
+  template <typename TSampleIterator>
+  void UpdateAllChannels(TSampleIterator begin_samples, TSampleIterator end_samples);
+
+  template <typename TSampleIterator, typename TKeyIterator>
+  void UpdateAllChannels(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys);
+
+  /*! Updates the consecutive channels starting at first_channel from
+   *  contiguous arrays. The range is checked once for the whole block,
+   *  so this is the preferred way to ingest complete sensor rings.
+   */
+  void UpdateChannels(size_t first_channel, const tSample *samples, size_t number_of_samples);
+
+  void UpdateChannels(size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples);
+
+  /*! Updates the channels listed in channels. Either all given channels
+   *  exist and all of them are updated, or none is.
+   */
+  void UpdateSelectedChannels(const size_t *channels, const tSample *samples, size_t number_of_samples);
+
+  void UpdateSelectedChannels(const size_t *channels, const tSample *samples, const double *keys, size_t number_of_samples);
+
+  inline const tSample &FusedValue()
+  {
+    RRLIB_DATA_FUSION_COUNT(fused_value_calls, 1);
+    if (RRLIB_DATA_FUSION_UNLIKELY(!this->IsValid()))
+    {
+      this->ThrowInvalidState();
+    }
+    return this->CachedFusedValue();
+  }
+
+  const bool IsValid() const;
+
+  /*! The Try methods are noexcept variants of UpdateChannel(s), IsValid
+   *  and FusedValue for threads that must not throw. They report errors
+   *  by status instead of exceptions and do not log.
+   *
+   *  Some channel policies (e.g. channel::Median) and fusers (e.g. the
+   *  first calculation of tMedianVoter) allocate memory. If that fails,
+   *  the Try methods return OUT_OF_MEMORY. A failed update clears the
+   *  updated channels, which become invalid. A failed calculation leaves
+   *  the fusion object unchanged, so the next call tries again.
+   */
+  tFusionStatus TryUpdateChannel(size_t channel, const tSample &sample, double key = 1) noexcept;
+
+  tFusionStatus TryUpdateChannels(size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples) noexcept;
+
+  //! OK if the fused value is available, otherwise NO_CHANNELS or INVALID_STATE
+  tFusionStatus Status() const noexcept;
+
+  inline tFusionResult<tSample> TryFusedValue() noexcept
+  {
+    RRLIB_DATA_FUSION_COUNT(fused_value_calls, 1);
+    tFusionStatus status = this->Status();
+    if (RRLIB_DATA_FUSION_UNLIKELY(status != tFusionStatus::OK))
+    {
+      return status;
+    }
+    try
+    {
+      return this->CachedFusedValue();
+    }
+    catch (const std::bad_alloc &)
+    {
+      return tFusionStatus::OUT_OF_MEMORY;
+    }
+  }
+
+  //! Clears the data of a single channel, which becomes invalid
+  void ClearChannel(size_t channel);
+
+  void ClearChannels();
+
+  void ResetState();
+
+  void EnterNextTimestep();
+
+#ifdef RRLIB_DATA_FUSION_PERFORMANCE_COUNTERS
+  inline const tPerformanceCounters &PerformanceCounters() const
+  {
+    return this->performance_counters;
+  }
+
+  inline void ResetPerformanceCounters()
+  {
+    this->performance_counters.Reset();
+  }
+#endif
+
+#ifdef RRLIB_DATA_FUSION_LATENCY_HISTOGRAMS
+  inline const tLatencyHistograms &LatencyHistograms() const
+  {
+    return this->latency_histograms;
+  }
+
+  inline void ResetLatencyHistograms()
+  {
+    this->latency_histograms.Reset();
+  }
+#endif
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  explicit tStaticDataFusion(tMemoryResource &resource = GetDefaultMemoryResource())
+    : channels(ConstructWithResource<tChannels>(resource)),
+      number_of_valid_channels(0),
+      data_changed(true),
+      memory_resource(&resource),
+      timestep_resource(resource)
+  {}
+
+  ~tStaticDataFusion()
+  {}
+
+  //! The resource given to the constructor
+  inline tMemoryResource &MemoryResource() const
+  {
+    return *this->memory_resource;
+  }
+
+  //! Arena for scratch buffers that are dropped in EnterNextTimestepImplementation
+  inline tMemoryResource &TimestepResource()
+  {
+    return this->timestep_resource;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tChannels channels;
+  size_t number_of_valid_channels;
+  TSample fused_value;
+  bool data_changed;
+  tMemoryResource *memory_resource;
+  tMonotonicBufferResource timestep_resource;
+#ifdef RRLIB_DATA_FUSION_PERFORMANCE_COUNTERS
+  mutable tPerformanceCounters performance_counters;
+#endif
+#ifdef RRLIB_DATA_FUSION_LATENCY_HISTOGRAMS
+  tLatencyHistograms latency_histograms;
+#endif
+
+  inline TFusion &Fusion()
+  {
+    return *static_cast<TFusion *>(this);
+  }
+
+  inline const TFusion &Fusion() const
+  {
+    return *static_cast<const TFusion *>(this);
+  }
+
+  const char *GetLogDescription() const
+  {
+    return this->Fusion().GetLogDescription();
+  }
+
+  void UpdateChannelImplementation(const tChannels &, size_t)
+  {}
+
+  inline void AddSample(size_t channel, const tSample &sample, double key);
+
+  void ClearChannelData(size_t channel);
+
+  template <typename TChannels>
+  void AddSamples(TChannels &storage, size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples);
+
+  void AddSamples(tChannelBank<TSample> &storage, size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples);
+
+  inline const tSample &CachedFusedValue()
+  {
+    RRLIB_DATA_FUSION_MEASURE_LATENCY(fused_value_cache_hit);
+    if (this->data_changed)
+    {
+      RRLIB_DATA_FUSION_COUNT(recalculations, 1);
+      RRLIB_DATA_FUSION_ATTRIBUTE_LATENCY(fused_value_recalculation);
+      RRLIB_DATA_FUSION_TIME_CALCULATION();
+      RRLIB_DATA_FUSION_TRACE("CalculateFusedValue", this->GetLogDescription());
+      this->fused_value = this->Fusion().CalculateFusedValue(this->channels);
+      this->data_changed = false;
+    }
+    else
+    {
+      RRLIB_DATA_FUSION_COUNT(cache_hits, 1);
+    }
+    return this->fused_value;
+  }
+
+  inline bool ChannelRangeExists(size_t first_channel, size_t number_of_channels) const
+  {
+    return first_channel + number_of_channels <= this->channels.size() && first_channel + number_of_channels >= first_channel;
+  }
+
+  inline void CheckChannelRange(size_t first_channel, size_t number_of_channels) const
+  {
+    if (RRLIB_DATA_FUSION_UNLIKELY(!this->ChannelRangeExists(first_channel, number_of_channels)))
+    {
+      this->ThrowChannelRangeError(first_channel, number_of_channels);
+    }
+  }
+
+  [[noreturn]] RRLIB_DATA_FUSION_COLD void ThrowChannelRangeError(size_t first_channel, size_t number_of_channels) const;
+
+  [[noreturn]] RRLIB_DATA_FUSION_COLD void ThrowNoChannels() const;
+
+  [[noreturn]] RRLIB_DATA_FUSION_COLD void ThrowInvalidState() const;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/data_fusion/tStaticDataFusion.hpp"
+
+#endif
@@ -0,0 +1,427 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tStaticDataFusion.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <sstream>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tStaticDataFusion SetNumberOfChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::SetNumberOfChannels(size_t number_of_channels)
+{
+  for (size_t i = number_of_channels; i < this->channels.size(); ++i)
+  {
+    this->number_of_valid_channels -= this->channels[i].IsValid();
+  }
+  tScopedMemoryResource scope(*this->memory_resource);
+  this->channels.resize(number_of_channels);
+  this->data_changed = true;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion UpdateChannel
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateChannel(size_t channel, const tSample &sample, double key)
+{
+  RRLIB_DATA_FUSION_MEASURE_LATENCY(update_channel);
+  RRLIB_DATA_FUSION_TRACE_CHANNEL("UpdateChannel", this->GetLogDescription(), channel);
+  this->CheckChannelRange(channel, 1);
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Updating channel ", channel, " with sample ", sample, " and key ", key);
+  RRLIB_DATA_FUSION_COUNT(update_calls, 1);
+  RRLIB_DATA_FUSION_COUNT(samples, 1);
+  this->AddSample(channel, sample, key);
+  this->data_changed = true;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion UpdateAllChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+template <typename TSampleIterator>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateAllChannels(TSampleIterator begin_samples, TSampleIterator end_samples)
+{
+  size_t channel = 0;
+  TSampleIterator sample = begin_samples;
+  while (sample != end_samples)
+  {
+    this->UpdateChannel(channel++, *(sample++));
+  }
+}
+
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+template <typename TSampleIterator, typename TKeyIterator>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateAllChannels(TSampleIterator begin_samples, TSampleIterator end_samples, TKeyIterator begin_keys, TKeyIterator end_keys)
+{
+  size_t channel = 0;
+  TSampleIterator sample = begin_samples;
+  TKeyIterator key = begin_keys;
+  while (sample != end_samples && key != end_keys)
+  {
+    this->UpdateChannel(channel++, *(sample++), *(key++));
+  }
+
+  if (sample != end_samples || key != end_keys)
+  {
+    RRLIB_DATA_FUSION_COUNT(exceptions, 1);
+    throw std::runtime_error("Number of samples did not match number of keys!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion UpdateChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateChannels(size_t first_channel, const tSample *samples, size_t number_of_samples)
+{
+  this->UpdateChannels(first_channel, samples, 0, number_of_samples);
+}
+
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateChannels(size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples)
+{
+  RRLIB_DATA_FUSION_TRACE_CHANNEL("UpdateChannels", this->GetLogDescription(), first_channel);
+  this->CheckChannelRange(first_channel, number_of_samples);
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Updating ", number_of_samples, " channels starting at channel ", first_channel, ".");
+  RRLIB_DATA_FUSION_COUNT(update_calls, 1);
+  RRLIB_DATA_FUSION_COUNT(samples, number_of_samples);
+  this->AddSamples(this->channels, first_channel, samples, keys, number_of_samples);
+  this->data_changed = true;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion UpdateSelectedChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateSelectedChannels(const size_t *channels, const tSample *samples, size_t number_of_samples)
+{
+  this->UpdateSelectedChannels(channels, samples, 0, number_of_samples);
+}
+
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::UpdateSelectedChannels(const size_t *channels, const tSample *samples, const double *keys, size_t number_of_samples)
+{
+  RRLIB_DATA_FUSION_TRACE("UpdateSelectedChannels", this->GetLogDescription());
+  if (number_of_samples > 0)
+  {
+    this->CheckChannelRange(*std::max_element(channels, channels + number_of_samples), 1);
+  }
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Updating ", number_of_samples, " selected channels.");
+  RRLIB_DATA_FUSION_COUNT(update_calls, 1);
+  RRLIB_DATA_FUSION_COUNT(samples, number_of_samples);
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    this->AddSample(channels[i], samples[i], keys ? keys[i] : 1);
+  }
+  this->data_changed = true;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion IsValid
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+const bool tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::IsValid() const
+{
+  if (RRLIB_DATA_FUSION_UNLIKELY(this->channels.empty()))
+  {
+    this->ThrowNoChannels();
+  }
+  return this->number_of_valid_channels == this->channels.size() && this->Fusion().HasValidState();
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion TryUpdateChannel
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+tFusionStatus tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::TryUpdateChannel(size_t channel, const tSample &sample, double key) noexcept
+{
+  if (RRLIB_DATA_FUSION_UNLIKELY(channel >= this->channels.size()))
+  {
+    return tFusionStatus::CHANNEL_OUT_OF_RANGE;
+  }
+  RRLIB_DATA_FUSION_MEASURE_LATENCY(update_channel);
+  RRLIB_DATA_FUSION_TRACE_CHANNEL("UpdateChannel", this->GetLogDescription(), channel);
+  RRLIB_DATA_FUSION_COUNT(update_calls, 1);
+  RRLIB_DATA_FUSION_COUNT(samples, 1);
+  this->data_changed = true;
+  try
+  {
+    this->AddSample(channel, sample, key);
+  }
+  catch (const std::bad_alloc &)
+  {
+    this->ClearChannelData(channel);
+    return tFusionStatus::OUT_OF_MEMORY;
+  }
+  return tFusionStatus::OK;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion TryUpdateChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+tFusionStatus tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::TryUpdateChannels(size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples) noexcept
+{
+  if (RRLIB_DATA_FUSION_UNLIKELY(!this->ChannelRangeExists(first_channel, number_of_samples)))
+  {
+    return tFusionStatus::CHANNEL_OUT_OF_RANGE;
+  }
+  RRLIB_DATA_FUSION_TRACE_CHANNEL("UpdateChannels", this->GetLogDescription(), first_channel);
+  RRLIB_DATA_FUSION_COUNT(update_calls, 1);
+  RRLIB_DATA_FUSION_COUNT(samples, number_of_samples);
+  this->data_changed = true;
+  try
+  {
+    this->AddSamples(this->channels, first_channel, samples, keys, number_of_samples);
+  }
+  catch (const std::bad_alloc &)
+  {
+    for (size_t channel = first_channel; channel < first_channel + number_of_samples; ++channel)
+    {
+      this->ClearChannelData(channel);
+    }
+    return tFusionStatus::OUT_OF_MEMORY;
+  }
+  return tFusionStatus::OK;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion Status
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+tFusionStatus tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::Status() const noexcept
+{
+  if (RRLIB_DATA_FUSION_UNLIKELY(this->channels.empty()))
+  {
+    return tFusionStatus::NO_CHANNELS;
+  }
+  return this->number_of_valid_channels == this->channels.size() && this->Fusion().HasValidState() ? tFusionStatus::OK : tFusionStatus::INVALID_STATE;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ClearChannel
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ClearChannel(size_t channel)
+{
+  RRLIB_DATA_FUSION_TRACE_CHANNEL("ClearChannel", this->GetLogDescription(), channel);
+  this->CheckChannelRange(channel, 1);
+  this->ClearChannelData(channel);
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ClearChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ClearChannels()
+{
+  RRLIB_DATA_FUSION_TRACE("ClearChannels", this->GetLogDescription());
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Clearing channels.");
+  for (typename tChannels::iterator it = this->channels.begin(); it != this->channels.end(); ++it)
+  {
+    it->ClearData();
+  }
+  this->number_of_valid_channels = 0;
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ResetState
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ResetState()
+{
+  RRLIB_DATA_FUSION_TRACE("ResetState", this->GetLogDescription());
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Resetting state.");
+  this->ClearChannels();
+  this->Fusion().ResetStateImplementation();
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion EnterNextTimestep()
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::EnterNextTimestep()
+{
+  RRLIB_DATA_FUSION_MEASURE_LATENCY(enter_next_timestep);
+  RRLIB_DATA_FUSION_TRACE("EnterNextTimestep", this->GetLogDescription());
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Clearing channels.");
+  this->number_of_valid_channels = 0;
+  size_t channel = 0;
+  for (typename tChannels::iterator it = this->channels.begin(); it != this->channels.end(); ++it, ++channel)
+  {
+    if (it->PrepareForNextTimestep())
+    {
+      this->data_changed = true;
+      this->Fusion().UpdateChannelImplementation(this->channels, channel);
+    }
+    this->number_of_valid_channels += it->IsValid();
+  }
+  this->Fusion().EnterNextTimestepImplementation();
+  this->timestep_resource.Release();
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion AddSample
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::AddSample(size_t channel, const tSample &sample, double key)
+{
+  auto &&updated_channel = this->channels[channel];
+  bool was_valid = updated_channel.IsValid();
+  updated_channel.AddSample(sample, key);
+  if (!was_valid && updated_channel.IsValid())
+  {
+    this->number_of_valid_channels++;
+  }
+  else if (was_valid && !updated_channel.IsValid())
+  {
+    this->number_of_valid_channels--;
+  }
+  this->Fusion().UpdateChannelImplementation(this->channels, channel);
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ClearChannelData
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ClearChannelData(size_t channel)
+{
+  auto &&cleared_channel = this->channels[channel];
+  this->number_of_valid_channels -= cleared_channel.IsValid();
+  cleared_channel.ClearData();
+  this->data_changed = true;
+  this->Fusion().UpdateChannelImplementation(this->channels, channel);
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion AddSamples
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+template <typename TChannels>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::AddSamples(TChannels &, size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples)
+{
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    this->AddSample(first_channel + i, samples[i], keys ? keys[i] : 1);
+  }
+}
+
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::AddSamples(tChannelBank<TSample> &storage, size_t first_channel, const tSample *samples, const double *keys, size_t number_of_samples)
+{
+  this->number_of_valid_channels += storage.Assign(first_channel, samples, keys, number_of_samples);
+  for (size_t i = first_channel; i < first_channel + number_of_samples; ++i)
+  {
+    this->Fusion().UpdateChannelImplementation(this->channels, i);
+  }
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ThrowChannelRangeError
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ThrowChannelRangeError(size_t first_channel, size_t number_of_channels) const
+{
+  std::stringstream stream;
+  if (number_of_channels > 1)
+  {
+    stream << "Channels " << first_channel << " to " << first_channel + (number_of_channels - 1) << " do not all exist";
+  }
+  else
+  {
+    stream << "Channel " << first_channel << " does not exist";
+  }
+  stream << " in fusion object with " << this->channels.size() << " channel" << (this->channels.size() == 1 ? "" : "s") << "!";
+  RRLIB_DATA_FUSION_COUNT(exceptions, 1);
+  throw std::runtime_error(stream.str());
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ThrowNoChannels
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ThrowNoChannels() const
+{
+  RRLIB_DATA_FUSION_COUNT(exceptions, 1);
+  throw std::logic_error("Number of channels must be greater than zero!");
+}
+
+//----------------------------------------------------------------------
+// tStaticDataFusion ThrowInvalidState
+//----------------------------------------------------------------------
+template <typename TFusion, typename TSample, template <typename> class TChannel, typename TStorage>
+void tStaticDataFusion<TFusion, TSample, TChannel, TStorage>::ThrowInvalidState() const
+{
+  RRLIB_DATA_FUSION_COUNT(exceptions, 1);
+  throw std::runtime_error("Fused value not available with invalid state!");
+}
+
+
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -37,19 +37,17 @@
 #define __rrlib__data_fusion__tWeightedAverage_h__
 
 #include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#ifdef _LIB_RRLIB_MATH_PRESENT_
-#include "rrlib/math/tAngle.h"
-#include "rrlib/math/tPose2D.h"
-#include "rrlib/math/tPose3D.h"
-#endif
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
+#include "rrlib/data_fusion/simd.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -70,255 +68,134 @@ namespace data_fusion
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of tWeightedAverageBase
-/*! A more detailed description of tWeightedAverageBase, which
- *  Tobias Foehst hasn't done yet !!
- */
+namespace internal
+{
+
+//! Implementation shared by tWeightedAverage and tStaticWeightedAverage
 template <
 typename TSample,
-         template <typename> class TChannel = channel::LastValue
+         template <typename> class TChannel,
+         typename TBase
          >
-class tWeightedAverage : public tDataFusion<TSample, TChannel>
+class tWeightedAverage : public TBase
 {
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource)
+  {}
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  virtual const char *GetLogDescription() const
+  const char *GetLogDescription() const
   {
     return "tWeightedAverage";
   }
 
-  virtual const bool HasValidState() const
+  const bool HasValidState() const
   {
     return true;
   }
 
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
   {
-    char buffer[sizeof(TSample)];
-    memset(buffer, 0, sizeof(buffer));
-    TSample *accumulated = new(buffer) TSample;
-    double accumulated_weights = 0;
+    return this->CalculateFusedValue(channels, simd::tHasKernels<typename TBase::tChannels>());
+  }
 
-    std::function<double(const TChannel<TSample> &)> weight_function = [](const TChannel<TSample> &channel)
-    {
-      return 1.0;
-    };
-    for (auto it = channels.begin(); it != channels.end(); ++it)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::true_type)
+  {
+    const double *keys = channels.Keys();
+    if (size_t(std::count(keys, keys + channels.size(), 0.0)) == channels.size())
     {
-      if (it->GetKey() != 0.0)
-      {
-        weight_function = [](const TChannel<TSample> &channel)
-        {
-          return channel.GetKey();
-        };
-        break;
-      }
+      return TSample(simd::Sum(channels.Samples(), channels.size()) * (1.0 / channels.size()));
     }
+    return TSample(simd::WeightedSum(channels.Samples(), keys, channels.size()) * (1.0 / simd::Sum(keys, channels.size())));
+  }
 
-    for (auto it = channels.begin(); it != channels.end(); ++it)
-    {
-      *accumulated += it->GetSample() * weight_function(*it);
-      accumulated_weights += weight_function(*it);
-    }
-    return *accumulated * (1.0 / accumulated_weights);
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::false_type)
+  {
+    return kernels::WeightedAverage<TSample>(kernels::ChannelSamples(channels.begin()), kernels::ChannelSamples(channels.end()), kernels::ChannelKeys(channels.begin()));
   }
 
-  virtual void ResetStateImplementation()
+  void ResetStateImplementation()
   {}
 
-  virtual void EnterNextTimestepImplementation()
+  void EnterNextTimestepImplementation()
   {}
 
 };
 
-#ifdef _LIB_RRLIB_MATH_PRESENT_
+}
 
-template <typename TElement, typename TUnitPolicy, typename TSignedPolicy, template <typename> class TChannel>
-class tWeightedAverage<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>, TChannel> : public tDataFusion<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>, TChannel>
+//! Short description of tWeightedAverageBase
+/*! A more detailed description of tWeightedAverageBase, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tWeightedAverage : public internal::tWeightedAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>
 {
 
-  typedef math::tAngle<TElement, TUnitPolicy, TSignedPolicy> tAngle;
-
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
-
-  virtual const char *GetLogDescription() const
-  {
-    return "tWeightedAverage<math::tAngle<...>>";
-  }
-
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
-
-  virtual const tAngle CalculateFusedValue(const std::vector<TChannel<tAngle>> &channels)
-  {
-    double accumulated_value = 0;
-    double accumulated_weights = 0;
-
-    std::function<double(const TChannel<tAngle> &)> weight_function = [](const TChannel<tAngle> &channel)
-    {
-      return 1.0;
-    };
-    for (auto it = channels.begin(); it != channels.end(); ++it)
-    {
-      if (it->GetKey() != 0.0)
-      {
-        weight_function = [](const TChannel<tAngle> &channel)
-        {
-          return channel.GetKey();
-        };
-        break;
-      }
-    }
-
-    for (typename std::vector<TChannel<tAngle>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      accumulated_value += static_cast<double>(it->GetSample()) * weight_function(*it);
-      accumulated_weights += weight_function(*it);
-    }
-    return tAngle(accumulated_value / accumulated_weights);
-  }
-
-  virtual void ResetStateImplementation()
-  {}
+public:
 
-  virtual void EnterNextTimestepImplementation()
+  explicit tWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tWeightedAverage<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
   {}
 
 };
 
-template <template <typename> class TChannel>
-class tWeightedAverage<math::tPose2D, TChannel> : public tDataFusion<math::tPose2D, TChannel>
+//! Statically dispatched variant of tWeightedAverage
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticWeightedAverage : public internal::tWeightedAverage<TSample, TChannel, tStaticDataFusion<tStaticWeightedAverage<TSample, TChannel>, TSample, TChannel>>
 {
 
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
+public:
 
-  virtual const char *GetLogDescription() const
-  {
-    return "tWeightedAverage<math::tPose2D>";
-  }
-
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
-
-  virtual const math::tPose2D CalculateFusedValue(const std::vector<TChannel<math::tPose2D>> &channels)
-  {
-    math::tVec2d accumulated_position;
-    math::tAngle<double, math::angle::Radian, math::angle::NoWrap> accumulated_yaw;
-    double accumulated_weights = 0;
-
-    std::function<double(const TChannel<math::tPose2D> &)> weight_function = [](const TChannel<math::tPose2D> &channel)
-    {
-      return 1.0;
-    };
-    for (auto it = channels.begin(); it != channels.end(); ++it)
-    {
-      if (it->GetKey() != 0.0)
-      {
-        weight_function = [](const TChannel<math::tPose2D> &channel)
-        {
-          return channel.GetKey();
-        };
-        break;
-      }
-    }
-
-    for (typename std::vector<TChannel<math::tPose2D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      accumulated_position += it->GetSample().Position() * weight_function(*it);
-      accumulated_yaw += it->GetSample().Yaw() * weight_function(*it);
-      accumulated_weights += weight_function(*it);
-    }
-    double factor = 1.0 / accumulated_weights;
-    return math::tPose2D(accumulated_position * factor, math::tAngleRad(accumulated_yaw * factor));
-  }
-
-  virtual void ResetStateImplementation()
-  {}
-
-  virtual void EnterNextTimestepImplementation()
+  explicit tStaticWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tWeightedAverage<TSample, TChannel, tStaticDataFusion<tStaticWeightedAverage<TSample, TChannel>, TSample, TChannel>>(resource)
   {}
 
 };
 
-template <template <typename> class TChannel>
-class tWeightedAverage<math::tPose3D, TChannel> : public tDataFusion<math::tPose3D, TChannel>
+//! Variant of tStaticWeightedAverage with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedWeightedAverage : public internal::tWeightedAverage<TSample, TChannel, tFixedDataFusion<tFixedWeightedAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
 {
 
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
-
-  virtual const char *GetLogDescription() const
-  {
-    return "tWeightedAverage<math::tPose3D>";
-  }
-
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
-
-  virtual const math::tPose3D CalculateFusedValue(const std::vector<TChannel<math::tPose3D>> &channels)
-  {
-    math::tVec3d accumulated_position;
-    double accumulated_roll = 0;
-    double accumulated_pitch = 0;
-    double accumulated_yaw = 0;
-    double accumulated_weights = 0;
+public:
 
-    std::function<double(const TChannel<math::tPose3D> &)> weight_function = [](const TChannel<math::tPose3D> &channel)
-    {
-      return 1.0;
-    };
-    for (auto it = channels.begin(); it != channels.end(); ++it)
-    {
-      if (it->GetKey() != 0.0)
-      {
-        weight_function = [](const TChannel<math::tPose3D> &channel)
-        {
-          return channel.GetKey();
-        };
-        break;
-      }
-    }
-
-    for (typename std::vector<TChannel<math::tPose3D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      accumulated_position += it->GetSample().Position() * weight_function(*it);
-      accumulated_roll += it->GetSample().Roll() * weight_function(*it);
-      accumulated_pitch += it->GetSample().Pitch() * weight_function(*it);
-      accumulated_yaw += it->GetSample().Yaw() * weight_function(*it);
-      accumulated_weights += weight_function(*it);
-    }
-    double factor = 1.0 / accumulated_weights;
-    return math::tPose3D(accumulated_position * factor, math::tAngleRad(accumulated_roll * factor), math::tAngleRad(accumulated_pitch * factor), math::tAngleRad(accumulated_yaw * factor));
-  }
-
-  virtual void ResetStateImplementation()
-  {}
-
-  virtual void EnterNextTimestepImplementation()
+  explicit tFixedWeightedAverage(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tWeightedAverage<TSample, TChannel, tFixedDataFusion<tFixedWeightedAverage<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
   {}
 
 };
 
-#endif
-
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
@@ -37,19 +37,17 @@
 #define __rrlib__data_fusion__tWeightedSum_h__
 
 #include "rrlib/data_fusion/tDataFusion.h"
+#include "rrlib/data_fusion/tFixedDataFusion.h"
 
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#ifdef _LIB_RRLIB_MATH_PRESENT_
-#include "rrlib/math/tAngle.h"
-#include "rrlib/math/tPose2D.h"
-#include "rrlib/math/tPose3D.h"
-#endif
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/data_fusion/kernels.h"
+#include "rrlib/data_fusion/simd.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -70,222 +68,129 @@ namespace data_fusion
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Short description of tWeightedSumBase
-/*! A more detailed description of tWeightedSumBase, which
- *  Tobias Foehst hasn't done yet !!
- */
+namespace internal
+{
+
+//! Implementation shared by tWeightedSum and tStaticWeightedSum
 template <
 typename TSample,
-         template <typename> class TChannel = channel::LastValue
+         template <typename> class TChannel,
+         typename TBase
          >
-class tWeightedSum : public tDataFusion<TSample, TChannel>
+class tWeightedSum : public TBase
 {
+  friend TBase;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  explicit tWeightedSum(tMemoryResource &resource = GetDefaultMemoryResource())
+    : TBase(resource)
+  {}
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  virtual const char *GetLogDescription() const
+  const char *GetLogDescription() const
   {
     return "tWeightedSum";
   }
 
-  virtual const bool HasValidState() const
+  const bool HasValidState() const
   {
     return true;
   }
 
-  virtual const TSample CalculateFusedValue(const std::vector<TChannel<TSample>> &channels)
-  {
-    char buffer[sizeof(TSample)];
-    memset(buffer, 0, sizeof(buffer));
-    TSample *accumulated = new(buffer) TSample;
-    double max_weight = 0;
-    for (typename std::vector<TChannel<TSample>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      max_weight = std::max(max_weight, it->GetKey());
-    }
-
-    if (max_weight != 0.0)
-    {
-
-      for (typename std::vector<TChannel<TSample>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-      {
-        double weight = it->GetKey() / max_weight;
-        *accumulated += it->GetSample() * weight;
-      }
-    }
-
-    return *accumulated;
-  }
-
-  virtual void ResetStateImplementation()
-  {}
-
-  virtual void EnterNextTimestepImplementation()
-  {}
-
-};
-
-#ifdef _LIB_RRLIB_MATH_PRESENT_
-
-template <typename TElement, typename TUnitPolicy, typename TSignedPolicy, template <typename> class TChannel>
-class tWeightedSum<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>, TChannel> : public tDataFusion<math::tAngle<TElement, TUnitPolicy, TSignedPolicy>, TChannel>
-{
-
-  typedef math::tAngle<TElement, TUnitPolicy, TSignedPolicy> tAngle;
-
-//----------------------------------------------------------------------
-// Private fields and methods
-//----------------------------------------------------------------------
-private:
-
-  virtual const char *GetLogDescription() const
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels)
   {
-    return "tWeightedSum<math::tAngle<...>>";
+    return this->CalculateFusedValue(channels, simd::tHasKernels<typename TBase::tChannels>());
   }
 
-  virtual const bool HasValidState() const
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::true_type)
   {
-    return true;
+    return TSample(simd::MaximumNormalizedWeightedSum(channels.Samples(), channels.Keys(), channels.size()));
   }
 
-  virtual const tAngle CalculateFusedValue(const std::vector<TChannel<tAngle>> &channels)
+  const TSample CalculateFusedValue(const typename TBase::tChannels &channels, std::false_type)
   {
-    double accumulated_value = 0;
-    double max_weight = 0;
-    for (typename std::vector<TChannel<tAngle>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      max_weight = std::max(max_weight, it->GetKey());
-    }
-
-    if (max_weight != 0.0)
-    {
-      for (typename std::vector<TChannel<tAngle>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-      {
-        double weight = it->GetKey() / max_weight;
-        accumulated_value += static_cast<double>(it->GetSample()) * weight;
-      }
-    }
-
-    return tAngle(accumulated_value);
+    return kernels::WeightedSum<TSample>(kernels::ChannelSamples(channels.begin()), kernels::ChannelSamples(channels.end()), kernels::ChannelKeys(channels.begin()));
   }
 
-  virtual void ResetStateImplementation()
+  void ResetStateImplementation()
   {}
 
-  virtual void EnterNextTimestepImplementation()
+  void EnterNextTimestepImplementation()
   {}
 
 };
 
-template <template <typename> class TChannel>
-class tWeightedSum<math::tPose2D, TChannel> : public tDataFusion<math::tPose2D, TChannel>
+}
+
+//! Short description of tWeightedSumBase
+/*! A more detailed description of tWeightedSumBase, which
+ *  Tobias Foehst hasn't done yet !!
+ */
+template <
+typename TSample,
+         template <typename> class TChannel = channel::LastValue
+         >
+class tWeightedSum : public internal::tWeightedSum<TSample, TChannel, tDataFusion<TSample, TChannel>>
 {
 
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
-
-  virtual const char *GetLogDescription() const
-  {
-    return "tWeightedSum<math::tPose2D>";
-  }
-
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
-
-  virtual const math::tPose2D CalculateFusedValue(const std::vector<TChannel<math::tPose2D>> &channels)
-  {
-    math::tVec2d accumulated_position;
-    math::tAngle<double, math::angle::Radian, math::angle::NoWrap> accumulated_yaw;
-    double max_weight = 0;
-    for (typename std::vector<TChannel<math::tPose2D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      max_weight = std::max(max_weight, it->GetKey());
-    }
-
-    if (max_weight != 0.0)
-    {
-      for (typename std::vector<TChannel<math::tPose2D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-      {
-        double weight = it->GetKey() / max_weight;
-        accumulated_position += it->GetSample().Position() * weight;
-        accumulated_yaw += it->GetSample().Yaw() * weight;
-      }
-    }
-
-    return math::tPose2D(accumulated_position, math::tAngleRad(accumulated_yaw));
-  }
-
-  virtual void ResetStateImplementation()
-  {}
+public:
 
-  virtual void EnterNextTimestepImplementation()
+  explicit tWeightedSum(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tWeightedSum<TSample, TChannel, tDataFusion<TSample, TChannel>>(resource)
   {}
 
 };
 
-template <template <typename> class TChannel>
-class tWeightedSum<math::tPose3D, TChannel> : public tDataFusion<math::tPose3D, TChannel>
+//! Statically dispatched variant of tWeightedSum
+template <
+typename TSample,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tStaticWeightedSum : public internal::tWeightedSum<TSample, TChannel, tStaticDataFusion<tStaticWeightedSum<TSample, TChannel>, TSample, TChannel>>
 {
 
 //----------------------------------------------------------------------
-// Private fields and methods
+// Public methods and typedefs
 //----------------------------------------------------------------------
-private:
+public:
 
-  virtual const char *GetLogDescription() const
-  {
-    return "tWeightedSum<math::tPose3D>";
-  }
+  explicit tStaticWeightedSum(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tWeightedSum<TSample, TChannel, tStaticDataFusion<tStaticWeightedSum<TSample, TChannel>, TSample, TChannel>>(resource)
+  {}
 
-  virtual const bool HasValidState() const
-  {
-    return true;
-  }
+};
 
-  virtual const math::tPose3D CalculateFusedValue(const std::vector<TChannel<math::tPose3D>> &channels)
-  {
-    math::tVec3d accumulated_position;
-    double accumulated_roll = 0;
-    double accumulated_pitch = 0;
-    double accumulated_yaw = 0;
-    double max_weight = 0;
-    for (typename std::vector<TChannel<math::tPose3D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-    {
-      max_weight = std::max(max_weight, it->GetKey());
-    }
-
-    if (max_weight != 0.0)
-    {
-      for (typename std::vector<TChannel<math::tPose3D>>::const_iterator it = channels.begin(); it != channels.end(); ++it)
-      {
-        double weight = it->GetKey() / max_weight;
-        accumulated_position += it->GetSample().Position() * weight;
-        accumulated_roll += it->GetSample().Roll() * weight;
-        accumulated_pitch += it->GetSample().Pitch() * weight;
-        accumulated_yaw += it->GetSample().Yaw() * weight;
-      }
-    }
-
-    return math::tPose3D(accumulated_position, math::tAngleRad(accumulated_roll), math::tAngleRad(accumulated_pitch), math::tAngleRad(accumulated_yaw));
-  }
+//! Variant of tStaticWeightedSum with a fixed number of channels
+template <
+typename TSample,
+         size_t Tnumber_of_channels,
+         template <typename> class TChannel = channel::StaticLastValue
+         >
+class tFixedWeightedSum : public internal::tWeightedSum<TSample, TChannel, tFixedDataFusion<tFixedWeightedSum<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>
+{
 
-  virtual void ResetStateImplementation()
-  {}
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
 
-  virtual void EnterNextTimestepImplementation()
+  explicit tFixedWeightedSum(tMemoryResource &resource = GetDefaultMemoryResource())
+    : internal::tWeightedSum<TSample, TChannel, tFixedDataFusion<tFixedWeightedSum<TSample, Tnumber_of_channels, TChannel>, TSample, Tnumber_of_channels, TChannel>>(resource)
   {}
 
 };
 
-#endif
-
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
@@ -0,0 +1,435 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    data_fusion/tests/benchmark.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * Throughput and latency of the fusers combined with the channel
+ * policies, sample types and channel counts, and of the FuseValuesUsing*
+ * helpers and the factory path. One cycle updates every channel once and
+ * reads the fused value.
+ *
+ * Usage: benchmark [--json] [--max-channels=N] [--min-time=SECONDS]
+ *
+ * The results are written to stdout as CSV (default) or JSON.
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/functions.h"
+#include "rrlib/data_fusion/factory.h"
+#include "rrlib/data_fusion/channels.h"
+#include "rrlib/data_fusion/tBatchedDataFusion.h"
+
+#include "rrlib/math/tPose2D.h"
+#include "rrlib/math/tPose3D.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace rrlib::data_fusion;
+using namespace rrlib;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cCHANNEL_COUNTS[] = { 2, 3, 10, 100, 1000, 10000, 100000 };
+const size_t cMINIMUM_NUMBER_OF_CYCLES = 5;
+const size_t cCHANNELS_PER_GROUP = 10;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+namespace
+{
+
+struct tResult
+{
+  std::string sample_type;
+  std::string fuser;
+  std::string channel_policy;
+  std::string path;
+  size_t channels;
+  size_t cycles;
+  double mean_ns;
+  double median_ns;
+  double p99_ns;
+  double max_ns;
+  double samples_per_second;
+};
+
+//! Keeps the compiler from optimizing away the computation of value
+template <typename T>
+inline void DoNotOptimize(const T &value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+class tBenchmark
+{
+public:
+
+  tBenchmark(double minimum_time, size_t maximum_number_of_channels)
+    : minimum_time(minimum_time),
+      maximum_number_of_channels(maximum_number_of_channels)
+  {}
+
+  inline bool Skip(size_t number_of_channels) const
+  {
+    return number_of_channels > this->maximum_number_of_channels;
+  }
+
+  //! Runs cycle repeatedly for at least the minimum time and records its latency
+  template <typename TCycle>
+  void Run(const char *sample_type, const char *fuser, const char *channel_policy, const char *path, size_t channels, TCycle cycle)
+  {
+    typedef std::chrono::steady_clock tClock;
+    std::vector<double> durations;
+    tClock::time_point start = tClock::now();
+    tClock::time_point now = start;
+    while (durations.size() < cMINIMUM_NUMBER_OF_CYCLES || std::chrono::duration<double>(now - start).count() < this->minimum_time)
+    {
+      tClock::time_point cycle_start = tClock::now();
+      cycle();
+      now = tClock::now();
+      durations.push_back(std::chrono::duration<double, std::nano>(now - cycle_start).count());
+    }
+
+    tResult result;
+    result.sample_type = sample_type;
+    result.fuser = fuser;
+    result.channel_policy = channel_policy;
+    result.path = path;
+    result.channels = channels;
+    result.cycles = durations.size();
+    double total = 0;
+    for (auto it = durations.begin(); it != durations.end(); ++it)
+    {
+      total += *it;
+    }
+    std::sort(durations.begin(), durations.end());
+    result.mean_ns = total / durations.size();
+    result.median_ns = durations[durations.size() / 2];
+    result.p99_ns = durations[std::min(durations.size() - 1, durations.size() * 99 / 100)];
+    result.max_ns = durations.back();
+    result.samples_per_second = channels * durations.size() / (total * 1E-9);
+    this->results.push_back(result);
+    std::cerr << sample_type << " " << fuser << " " << channel_policy << " " << path << " " << channels << ": " << result.median_ns << " ns" << std::endl;
+  }
+
+  void PrintCSV(std::ostream &stream) const
+  {
+    stream << "sample_type,fuser,channel_policy,path,channels,cycles,mean_ns,median_ns,p99_ns,max_ns,samples_per_second" << std::endl;
+    for (auto it = this->results.begin(); it != this->results.end(); ++it)
+    {
+      stream << it->sample_type << "," << it->fuser << "," << it->channel_policy << "," << it->path << "," << it->channels << "," << it->cycles << ","
+             << it->mean_ns << "," << it->median_ns << "," << it->p99_ns << "," << it->max_ns << "," << it->samples_per_second << std::endl;
+    }
+  }
+
+  void PrintJSON(std::ostream &stream) const
+  {
+    stream << "[" << std::endl;
+    for (auto it = this->results.begin(); it != this->results.end(); ++it)
+    {
+      stream << "  {\"sample_type\": \"" << it->sample_type << "\", \"fuser\": \"" << it->fuser << "\", \"channel_policy\": \"" << it->channel_policy
+             << "\", \"path\": \"" << it->path << "\", \"channels\": " << it->channels << ", \"cycles\": " << it->cycles
+             << ", \"mean_ns\": " << it->mean_ns << ", \"median_ns\": " << it->median_ns << ", \"p99_ns\": " << it->p99_ns
+             << ", \"max_ns\": " << it->max_ns << ", \"samples_per_second\": " << it->samples_per_second << "}"
+             << (it + 1 == this->results.end() ? "" : ",") << std::endl;
+    }
+    stream << "]" << std::endl;
+  }
+
+private:
+
+  double minimum_time;
+  size_t maximum_number_of_channels;
+  std::vector<tResult> results;
+
+};
+
+inline double MakeSample(size_t i, double)
+{
+  return (i * 7919 % 1000) * 1E-3;
+}
+
+inline math::tPose2D MakeSample(size_t i, math::tPose2D)
+{
+  double value = MakeSample(i, 0.0);
+  return math::tPose2D(value, 1 - value, math::tAngleRad(value));
+}
+
+inline math::tPose3D MakeSample(size_t i, math::tPose3D)
+{
+  double value = MakeSample(i, 0.0);
+  return math::tPose3D(value, 1 - value, value, math::tAngleRad(value), math::tAngleRad(0), math::tAngleRad(-value));
+}
+
+template <typename TSample>
+void MakeInput(size_t number_of_channels, std::vector<TSample> &samples, std::vector<double> &keys)
+{
+  samples.resize(number_of_channels);
+  keys.resize(number_of_channels);
+  for (size_t i = 0; i < number_of_channels; ++i)
+  {
+    samples[i] = MakeSample(i, TSample());
+    keys[i] = 1 + i % 7;
+  }
+}
+
+template <typename TSample, template <typename, template <typename> class> class TFusion, template <typename> class TChannel>
+void BenchmarkFuser(tBenchmark &benchmark, const char *sample_type, const char *fuser, const char *channel_policy)
+{
+  for (size_t number_of_channels : cCHANNEL_COUNTS)
+  {
+    if (benchmark.Skip(number_of_channels))
+    {
+      continue;
+    }
+    std::vector<TSample> samples;
+    std::vector<double> keys;
+    MakeInput(number_of_channels, samples, keys);
+    TFusion<TSample, TChannel> fusion;
+    fusion.SetNumberOfChannels(number_of_channels);
+    benchmark.Run(sample_type, fuser, channel_policy, "fuser", number_of_channels, [&]()
+    {
+      for (size_t i = 0; i < number_of_channels; ++i)
+      {
+        fusion.UpdateChannel(i, samples[i], keys[i]);
+      }
+      DoNotOptimize(fusion.FusedValue());
+      fusion.EnterNextTimestep();
+    });
+  }
+}
+
+template <typename TSample, template <typename, template <typename> class> class TFusion>
+void BenchmarkChannelPolicies(tBenchmark &benchmark, const char *sample_type, const char *fuser)
+{
+  BenchmarkFuser<TSample, TFusion, channel::LastValue>(benchmark, sample_type, fuser, "LastValue");
+  BenchmarkFuser<TSample, TFusion, channel::Average>(benchmark, sample_type, fuser, "Average");
+  BenchmarkFuser<TSample, TFusion, channel::Median>(benchmark, sample_type, fuser, "Median");
+}
+
+template <typename TSample>
+void BenchmarkHelpers(tBenchmark &benchmark, const char *sample_type)
+{
+  for (size_t number_of_channels : cCHANNEL_COUNTS)
+  {
+    if (benchmark.Skip(number_of_channels))
+    {
+      continue;
+    }
+    std::vector<TSample> s;
+    std::vector<double> k;
+    MakeInput(number_of_channels, s, k);
+    benchmark.Run(sample_type, "tMaximumKey", "LastValue", "FuseValuesUsing", number_of_channels, [&]()
+    {
+      DoNotOptimize(FuseValuesUsingMaximumKey<TSample>(s.begin(), s.end(), k.begin(), k.end()));
+    });
+    benchmark.Run(sample_type, "tAverage", "LastValue", "FuseValuesUsing", number_of_channels, [&]()
+    {
+      DoNotOptimize(FuseValuesUsingAverage<TSample>(s.begin(), s.end()));
+    });
+    benchmark.Run(sample_type, "tWeightedAverage", "LastValue", "FuseValuesUsing", number_of_channels, [&]()
+    {
+      DoNotOptimize(FuseValuesUsingWeightedAverage<TSample>(s.begin(), s.end(), k.begin(), k.end()));
+    });
+    benchmark.Run(sample_type, "tWeightedSum", "LastValue", "FuseValuesUsing", number_of_channels, [&]()
+    {
+      DoNotOptimize(FuseValuesUsingWeightedSum<TSample>(s.begin(), s.end(), k.begin(), k.end()));
+    });
+    benchmark.Run(sample_type, "tMedianVoter", "LastValue", "FuseValuesUsing", number_of_channels, [&]()
+    {
+      DoNotOptimize(FuseValuesUsingMedianVoter<TSample>(s.begin(), s.end()));
+    });
+    benchmark.Run(sample_type, "tMedianKeyVoter", "LastValue", "FuseValuesUsing", number_of_channels, [&]()
+    {
+      DoNotOptimize(FuseValuesUsingMedianKeyVoter<TSample>(s.begin(), s.end(), k.begin(), k.end()));
+    });
+  }
+}
+
+template <typename TSample>
+void BenchmarkFactory(tBenchmark &benchmark, const char *sample_type)
+{
+  const char *names[] = { "Maximum Key", "Average", "Weighted Average", "Weighted Sum", "Median Voter", "Median Key Voter" };
+  const char *fusers[] = { "tMaximumKey", "tAverage", "tWeightedAverage", "tWeightedSum", "tMedianVoter", "tMedianKeyVoter" };
+  InitializeFactory<TSample>();
+  for (size_t number_of_channels : cCHANNEL_COUNTS)
+  {
+    if (benchmark.Skip(number_of_channels))
+    {
+      continue;
+    }
+    std::vector<TSample> samples;
+    std::vector<double> keys;
+    MakeInput(number_of_channels, samples, keys);
+    for (size_t f = 0; f < sizeof(names) / sizeof(names[0]); ++f)
+    {
+      std::unique_ptr<tDataFusion<TSample>> fusion(tDataFusionFactory<TSample>::Instance().Create(names[f]));
+      fusion->SetNumberOfChannels(number_of_channels);
+      benchmark.Run(sample_type, fusers[f], "LastValue", "factory", number_of_channels, [&]()
+      {
+        fusion->UpdateChannels(0, samples.data(), keys.data(), number_of_channels);
+        DoNotOptimize(fusion->FusedValue());
+      });
+    }
+  }
+}
+
+template <typename TSample>
+void BenchmarkSampleType(tBenchmark &benchmark, const char *sample_type)
+{
+  BenchmarkChannelPolicies<TSample, tMaximumKey>(benchmark, sample_type, "tMaximumKey");
+  BenchmarkChannelPolicies<TSample, tAverage>(benchmark, sample_type, "tAverage");
+  BenchmarkChannelPolicies<TSample, tWeightedAverage>(benchmark, sample_type, "tWeightedAverage");
+  BenchmarkChannelPolicies<TSample, tWeightedSum>(benchmark, sample_type, "tWeightedSum");
+  BenchmarkChannelPolicies<TSample, tMedianVoter>(benchmark, sample_type, "tMedianVoter");
+  BenchmarkChannelPolicies<TSample, tMedianKeyVoter>(benchmark, sample_type, "tMedianKeyVoter");
+  BenchmarkHelpers<TSample>(benchmark, sample_type);
+  BenchmarkFactory<TSample>(benchmark, sample_type);
+}
+
+/*! One batched fuser for all groups against one object per group, with
+ *  the channel counts of the other benchmarks split into groups of
+ *  cCHANNELS_PER_GROUP channels.
+ */
+template <template <typename> class TStrategy, template <typename, template <typename> class> class TFusion>
+void BenchmarkBatchedFuser(tBenchmark &benchmark, const char *fuser)
+{
+  for (size_t number_of_channels : cCHANNEL_COUNTS)
+  {
+    if (benchmark.Skip(number_of_channels) || number_of_channels < cCHANNELS_PER_GROUP)
+    {
+      continue;
+    }
+    size_t number_of_groups = number_of_channels / cCHANNELS_PER_GROUP;
+    std::vector<double> samples;
+    std::vector<double> keys;
+    MakeInput(number_of_groups * cCHANNELS_PER_GROUP, samples, keys);
+
+    tBatchedDataFusion<double, TStrategy> batched(number_of_groups, cCHANNELS_PER_GROUP);
+    benchmark.Run("double", fuser, "Dense", "batched", number_of_channels, [&]()
+    {
+      for (size_t channel = 0; channel < cCHANNELS_PER_GROUP; ++channel)
+      {
+        batched.UpdateAllGroups(channel, samples.data() + channel * number_of_groups, keys.data() + channel * number_of_groups);
+      }
+      DoNotOptimize(batched.FusedValues()[0]);
+    });
+
+    std::vector<TFusion<double, channel::Dense>> objects(number_of_groups);
+    for (auto it = objects.begin(); it != objects.end(); ++it)
+    {
+      it->SetNumberOfChannels(cCHANNELS_PER_GROUP);
+    }
+    benchmark.Run("double", fuser, "Dense", "objects", number_of_channels, [&]()
+    {
+      for (size_t group = 0; group < number_of_groups; ++group)
+      {
+        objects[group].UpdateChannels(0, samples.data() + group * cCHANNELS_PER_GROUP, keys.data() + group * cCHANNELS_PER_GROUP, cCHANNELS_PER_GROUP);
+        DoNotOptimize(objects[group].FusedValue());
+      }
+    });
+  }
+}
+
+void BenchmarkBatched(tBenchmark &benchmark)
+{
+  BenchmarkBatchedFuser<batch::MaximumKey, tStaticMaximumKey>(benchmark, "tMaximumKey");
+  BenchmarkBatchedFuser<batch::Average, tStaticAverage>(benchmark, "tAverage");
+  BenchmarkBatchedFuser<batch::WeightedAverage, tStaticWeightedAverage>(benchmark, "tWeightedAverage");
+  BenchmarkBatchedFuser<batch::WeightedSum, tStaticWeightedSum>(benchmark, "tWeightedSum");
+}
+
+}
+
+int main(int argc, char **argv)
+{
+  bool json = false;
+  size_t maximum_number_of_channels = 100000;
+  double minimum_time = 0.05;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--json") == 0)
+    {
+      json = true;
+    }
+    else if (std::strncmp(argv[i], "--max-channels=", 15) == 0)
+    {
+      maximum_number_of_channels = std::strtoul(argv[i] + 15, 0, 10);
+    }
+    else if (std::strncmp(argv[i], "--min-time=", 11) == 0)
+    {
+      minimum_time = std::strtod(argv[i] + 11, 0);
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--json] [--max-channels=N] [--min-time=SECONDS]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  tBenchmark benchmark(minimum_time, maximum_number_of_channels);
+  BenchmarkSampleType<double>(benchmark, "double");
+  BenchmarkBatched(benchmark);
+  BenchmarkSampleType<math::tPose2D>(benchmark, "tPose2D");
+  BenchmarkSampleType<math::tPose3D>(benchmark, "tPose3D");
+
+  if (json)
+  {
+    benchmark.PrintJSON(std::cout);
+  }
+  else
+  {
+    benchmark.PrintCSV(std::cout);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    data_fusion/tests/instrumentation.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * Tests of the performance counters, latency histograms and tracing.
+ * They are compiled into fusion objects only when the corresponding
+ * macros are defined, which this program does before including any
+ * header of the library. The regular unit tests keep the default
+ * configuration.
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/util/tUnitTestSuite.h"
+
+#ifndef RRLIB_DATA_FUSION_PERFORMANCE_COUNTERS
+#define RRLIB_DATA_FUSION_PERFORMANCE_COUNTERS
+#endif
+#ifndef RRLIB_DATA_FUSION_LATENCY_HISTOGRAMS
+#define RRLIB_DATA_FUSION_LATENCY_HISTOGRAMS
+#endif
+#ifndef RRLIB_DATA_FUSION_TRACING
+#define RRLIB_DATA_FUSION_TRACING
+#endif
+
+#include "rrlib/data_fusion/tAverage.h"
+#include "rrlib/data_fusion/tMedianVoter.h"
+#include "rrlib/data_fusion/tracing.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cNUMBER_OF_SAMPLES = 5;
+const double data[cNUMBER_OF_SAMPLES] = { 0.4, 0.1, 0.2, 0.5, 0.8 };
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+class Instrumentation : public util::tUnitTestSuite
+{
+  RRLIB_UNIT_TESTS_BEGIN_SUITE(Instrumentation);
+  RRLIB_UNIT_TESTS_ADD_TEST(PerformanceCounters);
+  RRLIB_UNIT_TESTS_ADD_TEST(LatencyHistograms);
+  RRLIB_UNIT_TESTS_ADD_TEST(Tracing);
+  RRLIB_UNIT_TESTS_END_SUITE;
+
+private:
+
+  void PerformanceCounters()
+  {
+    tAverage<double> fusion;
+    fusion.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    fusion.UpdateChannels(0, data, cNUMBER_OF_SAMPLES);
+    fusion.UpdateChannel(0, 0.4);
+    fusion.FusedValue();
+    fusion.FusedValue();
+    RRLIB_UNIT_TESTS_EXCEPTION(fusion.UpdateChannel(cNUMBER_OF_SAMPLES, 0.4), std::runtime_error);
+
+    const tPerformanceCounters &counters = fusion.PerformanceCounters();
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(2), counters.update_calls.load());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(cNUMBER_OF_SAMPLES + 1), counters.samples.load());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(2), counters.fused_value_calls.load());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1), counters.recalculations.load());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1), counters.cache_hits.load());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1), counters.exceptions.load());
+
+    fusion.ResetPerformanceCounters();
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(0), counters.fused_value_calls.load());
+  }
+
+  void LatencyHistograms()
+  {
+    tLatencyHistogram histogram;
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(0), histogram.Percentile(0.5));
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+      histogram.Record(i * 1000);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1000), histogram.Count());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1000000), histogram.Maximum());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1000000), histogram.Percentile(1));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(500000.0, histogram.Percentile(0.5), 500000 * 0.125);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(990000.0, histogram.Percentile(0.99), 990000 * 0.125);
+    RRLIB_UNIT_TESTS_ASSERT(histogram.Percentile(0.5) >= 500000);
+    histogram.Record(7);
+    histogram.Record(uint64_t(1) << 50);
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1) << 50, histogram.Percentile(1));
+
+    tStaticMedianVoter<double> fusion;
+    fusion.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    fusion.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    fusion.FusedValue();
+    fusion.FusedValue();
+    fusion.FusedValue();
+    fusion.EnterNextTimestep();
+    const tLatencyHistograms &histograms = fusion.LatencyHistograms();
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(cNUMBER_OF_SAMPLES), histograms.update_channel.Count());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1), histograms.fused_value_recalculation.Count());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(2), histograms.fused_value_cache_hit.Count());
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(1), histograms.enter_next_timestep.Count());
+    RRLIB_UNIT_TESTS_ASSERT(histograms.fused_value_recalculation.Percentile(0.5) <= histograms.fused_value_recalculation.Maximum());
+    fusion.ResetLatencyHistograms();
+    RRLIB_UNIT_TESTS_EQUALITY(uint64_t(0), histograms.update_channel.Count());
+  }
+
+  void Tracing()
+  {
+    tracing::Clear();
+    tStaticMedianVoter<double> fusion;
+    fusion.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    fusion.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    fusion.FusedValue();
+    fusion.FusedValue();
+    fusion.EnterNextTimestep();
+    std::thread([&fusion]()
+    {
+      fusion.ResetState();
+    }).join();
+
+    std::vector<tracing::tEvent> events;
+    tracing::ThreadBuffer().Read(events);
+    events.erase(std::remove_if(events.begin(), events.end(), [](const tracing::tEvent & event)
+    {
+      return std::string(event.description) == "channel";
+    }), events.end());
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(2 * (cNUMBER_OF_SAMPLES + 2)), events.size());
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("UpdateChannel"), std::string(events[0].name));
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(4), events[8].channel);
+    RRLIB_UNIT_TESTS_EQUALITY('E', events[9].phase);
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("CalculateFusedValue"), std::string(events[10].name));
+    RRLIB_UNIT_TESTS_ASSERT(events[10].timestamp <= events[11].timestamp);
+
+    std::stringstream trace;
+    tracing::WriteChromeTrace(trace);
+    std::string json = trace.str();
+    RRLIB_UNIT_TESTS_ASSERT(json.find("{\"name\":\"UpdateChannel\",\"cat\":\"tMedianVoter\",\"ph\":\"B\"") != std::string::npos);
+    RRLIB_UNIT_TESTS_ASSERT(json.find("\"args\":{\"channel\":4}") != std::string::npos);
+    RRLIB_UNIT_TESTS_ASSERT(json.find("\"name\":\"ResetState\"") != std::string::npos);
+    RRLIB_UNIT_TESTS_ASSERT(json.find("\"name\":\"ClearChannels\"") > json.find("\"name\":\"ResetState\""));
+  }
+};
+
+RRLIB_UNIT_TESTS_REGISTER_SUITE(Instrumentation);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
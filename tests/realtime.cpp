@@ -0,0 +1,621 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    data_fusion/tests/realtime.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * Checks that configured fusion objects are real-time safe after warm-up.
+ * Every combination of fuser, channel policy and dispatch variant runs
+ * UpdateChannel/FusedValue/EnterNextTimestep cycles. During the measured
+ * cycles, malloc, free and operator new/delete are interposed and every
+ * call is counted. So is every exception (throwing allocates, too). The
+ * FuseValuesUsing* helpers and fusers created by the factory are checked
+ * the same way.
+ *
+ * Every combination runs once per number of channels. The default sizes
+ * are below and above the stack capacity of the median helpers
+ * (cMEDIAN_STACK_CAPACITY). Above it, the helpers are only checked with
+ * a scratch range, as they allocate otherwise. Fusers with a fixed
+ * number of channels are checked with both default sizes.
+ *
+ * Usage: realtime [--cycles=N] [--channels=N[,N...]] [--warm-up=N]
+ *
+ * Prints one line per combination with the number of channels, the
+ * number of allocations and exceptions and the median, 99.99th percentile
+ * and worst-case cycle time. The exit code is non-zero if any combination
+ * allocated or threw.
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/data_fusion/functions.h"
+#include "rrlib/data_fusion/factory.h"
+#include "rrlib/data_fusion/channels.h"
+#include "rrlib/data_fusion/tIncrementalAverage.h"
+#include "rrlib/data_fusion/tIncrementalWeightedAverage.h"
+#include "rrlib/data_fusion/tLatencyHistogram.h"
+
+#include "rrlib/math/tPose2D.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <ratio>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace rrlib::data_fusion;
+using namespace rrlib;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cSMALL_NUMBER_OF_CHANNELS = 5;
+const size_t cLARGE_NUMBER_OF_CHANNELS = 100;
+
+static_assert(cSMALL_NUMBER_OF_CHANNELS <= cMEDIAN_STACK_CAPACITY && cLARGE_NUMBER_OF_CHANNELS > cMEDIAN_STACK_CAPACITY, "The default sizes must cover both sides of the stack capacity");
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+namespace
+{
+
+std::atomic<bool> armed(false);
+std::atomic<size_t> allocations(0);
+
+inline void RecordAllocation()
+{
+  if (armed.load(std::memory_order_relaxed))
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}
+
+/*! With glibc, the C allocation functions are replaced as well and
+ *  forward to the glibc implementation. Elsewhere only operator new and
+ *  delete are checked.
+ */
+#ifdef __GLIBC__
+extern "C"
+{
+  void *__libc_malloc(size_t size);
+  void *__libc_calloc(size_t number, size_t size);
+  void *__libc_realloc(void *pointer, size_t size);
+  void *__libc_memalign(size_t alignment, size_t size);
+  void __libc_free(void *pointer);
+
+  void *malloc(size_t size)
+  {
+    RecordAllocation();
+    return __libc_malloc(size);
+  }
+
+  void *calloc(size_t number, size_t size)
+  {
+    RecordAllocation();
+    return __libc_calloc(number, size);
+  }
+
+  void *realloc(void *pointer, size_t size)
+  {
+    RecordAllocation();
+    return __libc_realloc(pointer, size);
+  }
+
+  void *memalign(size_t alignment, size_t size)
+  {
+    RecordAllocation();
+    return __libc_memalign(alignment, size);
+  }
+
+  void *aligned_alloc(size_t alignment, size_t size)
+  {
+    RecordAllocation();
+    return __libc_memalign(alignment, size);
+  }
+
+  int posix_memalign(void **pointer, size_t alignment, size_t size)
+  {
+    RecordAllocation();
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer ? 0 : ENOMEM;
+  }
+
+  void free(void *pointer)
+  {
+    if (pointer)
+    {
+      RecordAllocation();
+    }
+    __libc_free(pointer);
+  }
+}
+
+namespace
+{
+inline void *RawAllocate(size_t size)
+{
+  return __libc_malloc(size ? size : 1);
+}
+
+inline void RawFree(void *pointer)
+{
+  __libc_free(pointer);
+}
+}
+#else
+namespace
+{
+inline void *RawAllocate(size_t size)
+{
+  return std::malloc(size ? size : 1);
+}
+
+inline void RawFree(void *pointer)
+{
+  std::free(pointer);
+}
+}
+#endif
+
+void *operator new(size_t size)
+{
+  RecordAllocation();
+  void *pointer = RawAllocate(size);
+  if (!pointer)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  RecordAllocation();
+  return RawAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+  RecordAllocation();
+  return RawAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+  if (pointer)
+  {
+    RecordAllocation();
+  }
+  RawFree(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+  operator delete(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+  operator delete(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+  operator delete(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept
+{
+  operator delete(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept
+{
+  operator delete(pointer);
+}
+
+namespace
+{
+
+//! Keeps the compiler from optimizing away the computation of value
+template <typename T>
+inline void DoNotOptimize(const T &value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+class tHarness
+{
+public:
+
+  tHarness(size_t cycles, size_t warm_up_cycles)
+    : cycles(cycles),
+      warm_up_cycles(warm_up_cycles),
+      number_of_channels(0),
+      failures(0),
+      runs(0)
+  {}
+
+  inline size_t NumberOfChannels() const
+  {
+    return this->number_of_channels;
+  }
+
+  inline void SetNumberOfChannels(size_t number_of_channels)
+  {
+    this->number_of_channels = number_of_channels;
+  }
+
+  inline bool Passed() const
+  {
+    return this->failures == 0;
+  }
+
+  void PrintSummary() const
+  {
+    std::printf("%zu of %zu combinations are real-time safe\n", this->runs - this->failures, this->runs);
+  }
+
+  /*! Calls cycle(i) for the warm-up cycles and then for the measured
+   *  cycles, which must neither allocate nor throw.
+   */
+  template <typename TCycle>
+  void Run(const char *sample_type, const char *fuser, const char *channel_policy, TCycle cycle)
+  {
+    typedef std::chrono::steady_clock tClock;
+    for (size_t i = 0; i < this->warm_up_cycles; ++i)
+    {
+      cycle(i);
+    }
+
+    tLatencyHistogram histogram;
+    size_t exceptions = 0;
+    allocations.store(0, std::memory_order_relaxed);
+    armed.store(true, std::memory_order_seq_cst);
+    for (size_t i = 0; i < this->cycles; ++i)
+    {
+      tClock::time_point start = tClock::now();
+      try
+      {
+        cycle(this->warm_up_cycles + i);
+      }
+      catch (...)
+      {
+        exceptions++;
+      }
+      histogram.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(tClock::now() - start).count());
+    }
+    armed.store(false, std::memory_order_seq_cst);
+
+    size_t allocation_count = allocations.load(std::memory_order_relaxed);
+    bool passed = allocation_count == 0 && exceptions == 0;
+    this->runs++;
+    this->failures += !passed;
+    std::printf("%s %-8s %-34s %-32s channels=%-4zu allocations=%zu exceptions=%zu median=%lluns p99.99=%lluns max=%lluns\n",
+                passed ? "PASS" : "FAIL", sample_type, fuser, channel_policy, this->number_of_channels, allocation_count, exceptions,
+                static_cast<unsigned long long>(histogram.Percentile(0.5)),
+                static_cast<unsigned long long>(histogram.Percentile(0.9999)),
+                static_cast<unsigned long long>(histogram.Maximum()));
+    std::fflush(stdout);
+  }
+
+private:
+
+  size_t cycles;
+  size_t warm_up_cycles;
+  size_t number_of_channels;
+  size_t failures;
+  size_t runs;
+
+};
+
+inline double MakeSample(size_t i, double)
+{
+  return (i * 7919 % 1000) * 1E-3;
+}
+
+inline math::tPose2D MakeSample(size_t i, math::tPose2D)
+{
+  double value = MakeSample(i, 0.0);
+  return math::tPose2D(value, 1 - value, math::tAngleRad(value));
+}
+
+//! Twice the number of channels, so that every cycle can start at a different offset
+template <typename TSample>
+void MakeInput(size_t number_of_channels, std::vector<TSample> &samples, std::vector<double> &keys)
+{
+  samples.resize(2 * number_of_channels);
+  keys.resize(2 * number_of_channels);
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    samples[i] = MakeSample(i, TSample());
+    keys[i] = 1 + i % 7;
+  }
+}
+
+template <typename TSample, typename TFusion>
+void CheckFusion(tHarness &harness, TFusion &fusion, const char *sample_type, const char *fuser, const char *channel_policy)
+{
+  size_t number_of_channels = fusion.NumberOfChannels();
+  std::vector<TSample> samples;
+  std::vector<double> keys;
+  MakeInput(number_of_channels, samples, keys);
+  harness.Run(sample_type, fuser, channel_policy, [&](size_t cycle)
+  {
+    size_t offset = cycle % number_of_channels;
+    for (size_t i = 0; i < number_of_channels; ++i)
+    {
+      fusion.UpdateChannel(i, samples[offset + i], keys[offset + i]);
+    }
+    DoNotOptimize(fusion.FusedValue());
+    fusion.EnterNextTimestep();
+  });
+}
+
+template <typename TSample, template <typename, template <typename> class> class TFusion, template <typename> class TChannel>
+void CheckFuser(tHarness &harness, const char *sample_type, const char *fuser, const char *channel_policy)
+{
+  TFusion<TSample, TChannel> fusion;
+  fusion.SetNumberOfChannels(harness.NumberOfChannels());
+  CheckFusion<TSample>(harness, fusion, sample_type, fuser, channel_policy);
+}
+
+template <typename TSample, template <typename, template <typename> class> class TFusion>
+void CheckChannelPolicies(tHarness &harness, const char *sample_type, const char *fuser)
+{
+  CheckFuser<TSample, TFusion, channel::LastValue>(harness, sample_type, fuser, "LastValue");
+  CheckFuser<TSample, TFusion, channel::Average>(harness, sample_type, fuser, "Average");
+  CheckFuser<TSample, TFusion, channel::Median>(harness, sample_type, fuser, "Median");
+  CheckFuser<TSample, TFusion, channel::ExponentialAverage<std::ratio<1, 4>>::Policy>(harness, sample_type, fuser, "ExponentialAverage");
+  CheckFuser<TSample, TFusion, channel::SlidingWindow<8>::Average>(harness, sample_type, fuser, "SlidingWindow::Average");
+  CheckFuser<TSample, TFusion, channel::SlidingWindow<8>::Median>(harness, sample_type, fuser, "SlidingWindow::Median");
+  CheckFuser<TSample, TFusion, channel::SlidingTimeWindow<8, std::ratio<1, 10>>::Average>(harness, sample_type, fuser, "SlidingTimeWindow::Average");
+  CheckFuser<TSample, TFusion, channel::Dense>(harness, sample_type, fuser, "Dense");
+}
+
+template <typename TSample, template <typename, template <typename> class> class TFusion>
+void CheckStaticChannelPolicies(tHarness &harness, const char *sample_type, const char *fuser)
+{
+  CheckFuser<TSample, TFusion, channel::StaticLastValue>(harness, sample_type, fuser, "StaticLastValue");
+  CheckFuser<TSample, TFusion, channel::StaticAverage>(harness, sample_type, fuser, "StaticAverage");
+  CheckFuser<TSample, TFusion, channel::StaticMedian>(harness, sample_type, fuser, "StaticMedian");
+  CheckFuser<TSample, TFusion, channel::ExponentialAverage<std::ratio<1, 4>>::StaticPolicy>(harness, sample_type, fuser, "ExponentialAverage::StaticPolicy");
+  CheckFuser<TSample, TFusion, channel::SlidingWindow<8>::StaticAverage>(harness, sample_type, fuser, "SlidingWindow::StaticAverage");
+  CheckFuser<TSample, TFusion, channel::SlidingWindow<8>::StaticMedian>(harness, sample_type, fuser, "SlidingWindow::StaticMedian");
+  CheckFuser<TSample, TFusion, channel::Dense>(harness, sample_type, fuser, "Dense");
+}
+
+template <template <typename, template <typename> class> class TFusion>
+void CheckQuantilePolicies(tHarness &harness, const char *fuser)
+{
+  CheckFuser<double, TFusion, channel::ApproximateMedian>(harness, "double", fuser, "ApproximateMedian");
+  CheckFuser<double, TFusion, channel::StaticApproximateMedian>(harness, "double", fuser, "StaticApproximateMedian");
+}
+
+template <typename TFusion>
+void CheckFixedFuser(tHarness &harness, const char *sample_type, const char *fuser)
+{
+  TFusion fusion;
+  harness.SetNumberOfChannels(fusion.NumberOfChannels());
+  CheckFusion<typename TFusion::tSample>(harness, fusion, sample_type, fuser, "StaticLastValue");
+}
+
+template <typename TSample, size_t Tnumber_of_channels>
+void CheckFixedFusers(tHarness &harness, const char *sample_type)
+{
+  CheckFixedFuser<tFixedMaximumKey<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedMaximumKey");
+  CheckFixedFuser<tFixedAverage<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedAverage");
+  CheckFixedFuser<tFixedWeightedAverage<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedWeightedAverage");
+  CheckFixedFuser<tFixedWeightedSum<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedWeightedSum");
+  CheckFixedFuser<tFixedMedianVoter<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedMedianVoter");
+  CheckFixedFuser<tFixedMedianKeyVoter<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedMedianKeyVoter");
+  CheckFixedFuser<tFixedIncrementalAverage<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedIncrementalAverage");
+  CheckFixedFuser<tFixedIncrementalWeightedAverage<TSample, Tnumber_of_channels>>(harness, sample_type, "tFixedIncrementalWeightedAverage");
+}
+
+template <typename TSample>
+void CheckSampleType(tHarness &harness, const char *sample_type)
+{
+  CheckChannelPolicies<TSample, tMaximumKey>(harness, sample_type, "tMaximumKey");
+  CheckChannelPolicies<TSample, tAverage>(harness, sample_type, "tAverage");
+  CheckChannelPolicies<TSample, tWeightedAverage>(harness, sample_type, "tWeightedAverage");
+  CheckChannelPolicies<TSample, tWeightedSum>(harness, sample_type, "tWeightedSum");
+  CheckChannelPolicies<TSample, tMedianVoter>(harness, sample_type, "tMedianVoter");
+  CheckChannelPolicies<TSample, tMedianKeyVoter>(harness, sample_type, "tMedianKeyVoter");
+  CheckChannelPolicies<TSample, tIncrementalAverage>(harness, sample_type, "tIncrementalAverage");
+  CheckChannelPolicies<TSample, tIncrementalWeightedAverage>(harness, sample_type, "tIncrementalWeightedAverage");
+
+  CheckStaticChannelPolicies<TSample, tStaticMaximumKey>(harness, sample_type, "tStaticMaximumKey");
+  CheckStaticChannelPolicies<TSample, tStaticAverage>(harness, sample_type, "tStaticAverage");
+  CheckStaticChannelPolicies<TSample, tStaticWeightedAverage>(harness, sample_type, "tStaticWeightedAverage");
+  CheckStaticChannelPolicies<TSample, tStaticWeightedSum>(harness, sample_type, "tStaticWeightedSum");
+  CheckStaticChannelPolicies<TSample, tStaticMedianVoter>(harness, sample_type, "tStaticMedianVoter");
+  CheckStaticChannelPolicies<TSample, tStaticMedianKeyVoter>(harness, sample_type, "tStaticMedianKeyVoter");
+  CheckStaticChannelPolicies<TSample, tStaticIncrementalAverage>(harness, sample_type, "tStaticIncrementalAverage");
+  CheckStaticChannelPolicies<TSample, tStaticIncrementalWeightedAverage>(harness, sample_type, "tStaticIncrementalWeightedAverage");
+}
+
+//! The helpers fuse one sample per channel, starting at a different offset in every cycle
+template <typename TSample>
+void CheckHelpers(tHarness &harness, const char *sample_type)
+{
+  size_t n = harness.NumberOfChannels();
+  std::vector<TSample> s;
+  std::vector<double> k;
+  MakeInput(n, s, k);
+  std::vector<TSample> sample_scratch(n);
+  std::vector<kernels::tIndexedKey> key_scratch(n);
+  harness.Run(sample_type, "FuseValuesUsingMaximumKey", "-", [&](size_t cycle)
+  {
+    size_t offset = cycle % n;
+    DoNotOptimize(FuseValuesUsingMaximumKey<TSample>(s.begin() + offset, s.begin() + offset + n, k.begin() + offset, k.begin() + offset + n));
+  });
+  harness.Run(sample_type, "FuseValuesUsingAverage", "-", [&](size_t cycle)
+  {
+    size_t offset = cycle % n;
+    DoNotOptimize(FuseValuesUsingAverage<TSample>(s.begin() + offset, s.begin() + offset + n));
+  });
+  harness.Run(sample_type, "FuseValuesUsingWeightedAverage", "-", [&](size_t cycle)
+  {
+    size_t offset = cycle % n;
+    DoNotOptimize(FuseValuesUsingWeightedAverage<TSample>(s.begin() + offset, s.begin() + offset + n, k.begin() + offset, k.begin() + offset + n));
+  });
+  harness.Run(sample_type, "FuseValuesUsingWeightedSum", "-", [&](size_t cycle)
+  {
+    size_t offset = cycle % n;
+    DoNotOptimize(FuseValuesUsingWeightedSum<TSample>(s.begin() + offset, s.begin() + offset + n, k.begin() + offset, k.begin() + offset + n));
+  });
+  if (n <= cMEDIAN_STACK_CAPACITY)
+  {
+    harness.Run(sample_type, "FuseValuesUsingMedianVoter", "-", [&](size_t cycle)
+    {
+      size_t offset = cycle % n;
+      DoNotOptimize(FuseValuesUsingMedianVoter<TSample>(s.begin() + offset, s.begin() + offset + n));
+    });
+    harness.Run(sample_type, "FuseValuesUsingMedianKeyVoter", "-", [&](size_t cycle)
+    {
+      size_t offset = cycle % n;
+      DoNotOptimize(FuseValuesUsingMedianKeyVoter<TSample>(s.begin() + offset, s.begin() + offset + n, k.begin() + offset, k.begin() + offset + n));
+    });
+  }
+  harness.Run(sample_type, "FuseValuesUsingMedianVoter", "scratch range", [&](size_t cycle)
+  {
+    size_t offset = cycle % n;
+    DoNotOptimize(FuseValuesUsingMedianVoter<TSample>(s.begin() + offset, s.begin() + offset + n, sample_scratch.begin(), sample_scratch.end()));
+  });
+  harness.Run(sample_type, "FuseValuesUsingMedianKeyVoter", "scratch range", [&](size_t cycle)
+  {
+    size_t offset = cycle % n;
+    DoNotOptimize(FuseValuesUsingMedianKeyVoter<TSample>(s.begin() + offset, s.begin() + offset + n, k.begin() + offset, k.begin() + offset + n, key_scratch.begin(), key_scratch.end()));
+  });
+}
+
+template <typename TSample>
+void CheckFactory(tHarness &harness, const char *sample_type)
+{
+  const char *names[] = { "Maximum Key", "Average", "Weighted Average", "Weighted Sum", "Median Voter", "Median Key Voter" };
+  InitializeFactory<TSample>();
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+  {
+    std::unique_ptr<tDataFusion<TSample>> fusion(tDataFusionFactory<TSample>::Instance().Create(names[i]));
+    fusion->SetNumberOfChannels(harness.NumberOfChannels());
+    CheckFusion<TSample>(harness, *fusion, sample_type, names[i], "factory");
+  }
+}
+
+}
+
+int main(int argc, char **argv)
+{
+  size_t cycles = 1000000;
+  size_t warm_up_cycles = 100;
+  std::vector<size_t> numbers_of_channels;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strncmp(argv[i], "--cycles=", 9) == 0)
+    {
+      cycles = std::strtoul(argv[i] + 9, 0, 10);
+    }
+    else if (std::strncmp(argv[i], "--channels=", 11) == 0)
+    {
+      for (char *number = argv[i] + 11; *number;)
+      {
+        numbers_of_channels.push_back(std::strtoul(number, &number, 10));
+        number += *number == ',';
+      }
+    }
+    else if (std::strncmp(argv[i], "--warm-up=", 10) == 0)
+    {
+      warm_up_cycles = std::strtoul(argv[i] + 10, 0, 10);
+    }
+    else
+    {
+      std::fprintf(stderr, "Usage: %s [--cycles=N] [--channels=N[,N...]] [--warm-up=N]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (numbers_of_channels.empty())
+  {
+    numbers_of_channels.push_back(cSMALL_NUMBER_OF_CHANNELS);
+    numbers_of_channels.push_back(cLARGE_NUMBER_OF_CHANNELS);
+  }
+  if (std::find(numbers_of_channels.begin(), numbers_of_channels.end(), 0) != numbers_of_channels.end())
+  {
+    std::fprintf(stderr, "Number of channels must be greater than zero!\n");
+    return EXIT_FAILURE;
+  }
+
+  tHarness harness(cycles, warm_up_cycles);
+  for (auto it = numbers_of_channels.begin(); it != numbers_of_channels.end(); ++it)
+  {
+    harness.SetNumberOfChannels(*it);
+    CheckSampleType<double>(harness, "double");
+    CheckSampleType<math::tPose2D>(harness, "tPose2D");
+    CheckQuantilePolicies<tMedianVoter>(harness, "tMedianVoter");
+    CheckQuantilePolicies<tStaticAverage>(harness, "tStaticAverage");
+    CheckHelpers<double>(harness, "double");
+    CheckHelpers<math::tPose2D>(harness, "tPose2D");
+    CheckFactory<double>(harness, "double");
+    CheckFactory<math::tPose2D>(harness, "tPose2D");
+  }
+  CheckFixedFusers<double, cSMALL_NUMBER_OF_CHANNELS>(harness, "double");
+  CheckFixedFusers<double, cLARGE_NUMBER_OF_CHANNELS>(harness, "double");
+  CheckFixedFusers<math::tPose2D, cSMALL_NUMBER_OF_CHANNELS>(harness, "tPose2D");
+  CheckFixedFusers<math::tPose2D, cLARGE_NUMBER_OF_CHANNELS>(harness, "tPose2D");
+  harness.PrintSummary();
+
+  return harness.Passed() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
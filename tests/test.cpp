@@ -36,9 +36,20 @@
 #include "rrlib/data_fusion/functions.h"
 #include "rrlib/data_fusion/factory.h"
 #include "rrlib/data_fusion/channels.h"
+#include "rrlib/data_fusion/tIncrementalAverage.h"
+#include "rrlib/data_fusion/tIncrementalWeightedAverage.h"
+#include "rrlib/data_fusion/tConcurrentDataFusion.h"
+#include "rrlib/data_fusion/tExpiringDataFusion.h"
+#include "rrlib/data_fusion/tBatchedDataFusion.h"
+#include "rrlib/data_fusion/simd.h"
 
 #include "rrlib/math/tPose2D.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
@@ -68,6 +79,7 @@ namespace data_fusion
 // Const values
 //----------------------------------------------------------------------
 const size_t cNUMBER_OF_SAMPLES = 5;
+const double data[cNUMBER_OF_SAMPLES] = { 0.4, 0.1, 0.2, 0.5, 0.8 };
 const double keys[cNUMBER_OF_SAMPLES] = { 2, 5, 3, 3, 1 };
 
 //----------------------------------------------------------------------
@@ -80,14 +92,34 @@ class Test : public util::tUnitTestSuite
   RRLIB_UNIT_TESTS_ADD_TEST(Pose);
   RRLIB_UNIT_TESTS_ADD_TEST(Factory);
   RRLIB_UNIT_TESTS_ADD_TEST(Channels);
+  RRLIB_UNIT_TESTS_ADD_TEST(StaticDispatch);
+  RRLIB_UNIT_TESTS_ADD_TEST(DenseChannels);
+  RRLIB_UNIT_TESTS_ADD_TEST(ValidChannelCount);
+  RRLIB_UNIT_TESTS_ADD_TEST(IncrementalAverage);
+  RRLIB_UNIT_TESTS_ADD_TEST(BulkUpdate);
+  RRLIB_UNIT_TESTS_ADD_TEST(FixedNumberOfChannels);
+  RRLIB_UNIT_TESTS_ADD_TEST(ConcurrentUpdates);
+  RRLIB_UNIT_TESTS_ADD_TEST(ConcurrentBatches);
+  RRLIB_UNIT_TESTS_ADD_TEST(BatchedFusion);
+  RRLIB_UNIT_TESTS_ADD_TEST(SimdKernels);
+  RRLIB_UNIT_TESTS_ADD_TEST(Selection);
+  RRLIB_UNIT_TESTS_ADD_TEST(MedianNetworks);
+  RRLIB_UNIT_TESTS_ADD_TEST(AveragingChannel);
+  RRLIB_UNIT_TESTS_ADD_TEST(RunningMedian);
+  RRLIB_UNIT_TESTS_ADD_TEST(QuantileEstimation);
+  RRLIB_UNIT_TESTS_ADD_TEST(SlidingWindow);
+  RRLIB_UNIT_TESTS_ADD_TEST(ExponentialAverage);
+  RRLIB_UNIT_TESTS_ADD_TEST(ChannelExpiry);
+  RRLIB_UNIT_TESTS_ADD_TEST(MemoryResources);
+  RRLIB_UNIT_TESTS_ADD_TEST(NoexceptInterface);
+  RRLIB_UNIT_TESTS_ADD_TEST(InjectedMemoryResources);
+  RRLIB_UNIT_TESTS_ADD_TEST(Kernels);
   RRLIB_UNIT_TESTS_END_SUITE;
 
 private:
 
   void Double()
   {
-    double data[cNUMBER_OF_SAMPLES] = { 0.4, 0.1, 0.2, 0.5, 0.8 };
-
     RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, FuseValuesUsingMaximumKey<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), 1E-6);
     RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, FuseValuesUsingAverage<double>(data, data + cNUMBER_OF_SAMPLES), 1E-6);
     RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, FuseValuesUsingWeightedAverage<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), 1E-6);
@@ -127,6 +159,938 @@ private:
   {
     tAverage<double, channel::Average> cyclic_fusion;
   }
+
+  void StaticDispatch()
+  {
+    tStaticMaximumKey<double> maximum_key;
+    tStaticAverage<double> average;
+    tStaticWeightedAverage<double> weighted_average;
+    tStaticMedianVoter<double> median_voter;
+    tStaticMedianKeyVoter<double, channel::StaticAverage> median_key_voter;
+
+    maximum_key.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    maximum_key.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValue(), 1E-6);
+
+    average.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, average.FusedValue(), 1E-6);
+
+    weighted_average.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    weighted_average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, weighted_average.FusedValue(), 1E-6);
+
+    median_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    median_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, median_voter.FusedValue(), 1E-6);
+
+    median_key_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    median_key_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, median_key_voter.FusedValue(), 1E-6);
+
+    median_key_voter.EnterNextTimestep();
+    RRLIB_UNIT_TESTS_ASSERT(!median_key_voter.IsValid());
+  }
+
+  void DenseChannels()
+  {
+    tWeightedAverage<double, channel::Dense> weighted_average;
+    weighted_average.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_ASSERT(!weighted_average.IsValid());
+    weighted_average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, weighted_average.FusedValue(), 1E-6);
+
+    tStaticMaximumKey<double, channel::Dense> maximum_key;
+    maximum_key.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    maximum_key.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValue(), 1E-6);
+
+    maximum_key.ClearChannels();
+    RRLIB_UNIT_TESTS_ASSERT(!maximum_key.IsValid());
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(0), maximum_key.NumberOfValidChannels());
+  }
+
+  void ValidChannelCount()
+  {
+    tAverage<double, channel::Average> fusion;
+    fusion.SetNumberOfChannels(3);
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(0), fusion.NumberOfValidChannels());
+
+    fusion.UpdateChannel(0, 0.1);
+    fusion.UpdateChannel(0, 0.2);
+    fusion.UpdateChannel(2, 0.3);
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(2), fusion.NumberOfValidChannels());
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid());
+
+    fusion.UpdateChannel(1, 0.4);
+    RRLIB_UNIT_TESTS_ASSERT(fusion.IsValid());
+
+    fusion.SetNumberOfChannels(2);
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(2), fusion.NumberOfValidChannels());
+
+    fusion.EnterNextTimestep();
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(0), fusion.NumberOfValidChannels());
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid());
+  }
+
+  void IncrementalAverage()
+  {
+    tIncrementalAverage<double> average;
+    tStaticIncrementalWeightedAverage<double> weighted_average;
+    average.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    weighted_average.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    average.SetRenormalizationInterval(0);
+    average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    weighted_average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, average.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, weighted_average.FusedValue(), 1E-6);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      average.UpdateChannel(i % cNUMBER_OF_SAMPLES, data[(i + 1) % cNUMBER_OF_SAMPLES]);
+      weighted_average.UpdateChannel(i % cNUMBER_OF_SAMPLES, data[(i + 1) % cNUMBER_OF_SAMPLES], keys[(i + 1) % cNUMBER_OF_SAMPLES]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, average.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, weighted_average.FusedValue(), 1E-6);
+
+    weighted_average.UpdateChannel(0, 1.0, 0);
+    weighted_average.UpdateChannel(1, 1.0, 0);
+    weighted_average.UpdateChannel(2, 1.0, 0);
+    weighted_average.UpdateChannel(3, 1.0, 0);
+    weighted_average.UpdateChannel(4, 2.0, 0);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(1.2, weighted_average.FusedValue(), 1E-6);
+  }
+
+  void BulkUpdate()
+  {
+    size_t selected[2] = { 4, 1 };
+
+    tWeightedAverage<double> fusion;
+    tStaticWeightedAverage<double, channel::Dense> dense_fusion;
+    fusion.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    dense_fusion.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+
+    fusion.UpdateChannels(1, data + 1, keys + 1, cNUMBER_OF_SAMPLES - 1);
+    dense_fusion.UpdateChannels(1, data + 1, keys + 1, cNUMBER_OF_SAMPLES - 1);
+    RRLIB_UNIT_TESTS_EQUALITY(cNUMBER_OF_SAMPLES - 1, fusion.NumberOfValidChannels());
+    RRLIB_UNIT_TESTS_EQUALITY(cNUMBER_OF_SAMPLES - 1, dense_fusion.NumberOfValidChannels());
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid());
+    RRLIB_UNIT_TESTS_ASSERT(!dense_fusion.IsValid());
+
+    fusion.UpdateChannels(0, data, keys, cNUMBER_OF_SAMPLES);
+    dense_fusion.UpdateChannels(0, data, keys, cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, fusion.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, dense_fusion.FusedValue(), 1E-6);
+
+    fusion.UpdateSelectedChannels(selected, data, 2);
+    dense_fusion.UpdateSelectedChannels(selected, data, 2);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE((0.4 * 2 + 0.1 * 1 + 0.2 * 3 + 0.5 * 3 + 0.4 * 1) / 10, fusion.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE((0.4 * 2 + 0.1 * 1 + 0.2 * 3 + 0.5 * 3 + 0.4 * 1) / 10, dense_fusion.FusedValue(), 1E-6);
+
+    selected[0] = cNUMBER_OF_SAMPLES;
+    RRLIB_UNIT_TESTS_EXCEPTION(fusion.UpdateSelectedChannels(selected, data, 2), std::runtime_error);
+    RRLIB_UNIT_TESTS_EXCEPTION(fusion.UpdateChannels(1, data, cNUMBER_OF_SAMPLES), std::runtime_error);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE((0.4 * 2 + 0.1 * 1 + 0.2 * 3 + 0.5 * 3 + 0.4 * 1) / 10, fusion.FusedValue(), 1E-6);
+  }
+
+  void FixedNumberOfChannels()
+  {
+    tFixedAverage<double, cNUMBER_OF_SAMPLES> average;
+    tFixedMedianVoter<double, cNUMBER_OF_SAMPLES> median_voter;
+    tFixedMedianKeyVoter<double, cNUMBER_OF_SAMPLES> median_key_voter;
+    tFixedMaximumKey<double, cNUMBER_OF_SAMPLES> maximum_key;
+    RRLIB_UNIT_TESTS_EQUALITY(cNUMBER_OF_SAMPLES, average.NumberOfChannels());
+    RRLIB_UNIT_TESTS_ASSERT(!average.IsValid());
+
+    average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    median_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    median_key_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    maximum_key.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, average.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, median_voter.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, median_key_voter.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValue(), 1E-6);
+
+    RRLIB_UNIT_TESTS_EXCEPTION(average.UpdateChannel(cNUMBER_OF_SAMPLES, 0.0), std::runtime_error);
+  }
+
+  static void WriteChannel(tConcurrentDataFusion<tFixedMaximumKey<double, 2>> *fusion, size_t channel, size_t number_of_updates)
+  {
+    for (size_t i = 1; i <= number_of_updates; ++i)
+    {
+      fusion->UpdateChannel(channel, i, i);
+    }
+  }
+
+  void ConcurrentUpdates()
+  {
+    const size_t cNUMBER_OF_UPDATES = 100000;
+    tConcurrentDataFusion<tFixedMaximumKey<double, 2>> fusion;
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(2), fusion.NumberOfChannels());
+
+    std::thread first_writer(&WriteChannel, &fusion, 0, cNUMBER_OF_UPDATES);
+    std::thread second_writer(&WriteChannel, &fusion, 1, cNUMBER_OF_UPDATES);
+    double last_value = 0;
+    bool consistent = true;
+    while (last_value < cNUMBER_OF_UPDATES)
+    {
+      if (fusion.IsValid())
+      {
+        double value = fusion.FusedValue();
+        consistent &= value >= last_value && value == fusion.Fusion().FusedValue();
+        last_value = value;
+      }
+    }
+    first_writer.join();
+    second_writer.join();
+
+    RRLIB_UNIT_TESTS_ASSERT(consistent);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(double(cNUMBER_OF_UPDATES), fusion.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(2), fusion.NumberOfValidChannels());
+  }
+
+  static void WriteBatches(tConcurrentDataFusion<tFixedAverage<double, 8>> *fusion, size_t number_of_updates)
+  {
+    for (size_t i = 1; i <= number_of_updates; ++i)
+    {
+      std::vector<double> samples(8, double(i));
+      fusion->UpdateChannels(0, samples.data(), samples.size());
+    }
+  }
+
+  void ConcurrentBatches()
+  {
+    const size_t cNUMBER_OF_UPDATES = 100000;
+    tConcurrentDataFusion<tFixedAverage<double, 8>> fusion;
+    std::thread writer(&WriteBatches, &fusion, cNUMBER_OF_UPDATES);
+    // all channels always have the same value, so a torn batch shows up as a fraction
+    double last_value = 0;
+    bool consistent = true;
+    while (last_value < cNUMBER_OF_UPDATES)
+    {
+      if (fusion.IsValid())
+      {
+        double value = fusion.FusedValue();
+        consistent &= value >= last_value && value == std::floor(value);
+        last_value = value;
+      }
+    }
+    writer.join();
+
+    RRLIB_UNIT_TESTS_ASSERT(consistent);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(double(cNUMBER_OF_UPDATES), fusion.FusedValue(), 1E-6);
+  }
+
+  template <template <typename> class TStrategy>
+  void FuseBatch(tBatchedDataFusion<double, TStrategy> &fusion, const double *data)
+  {
+    double zero_keys[cNUMBER_OF_SAMPLES] = { 0, 0, 0, 0, 0 };
+    fusion.Resize(3, cNUMBER_OF_SAMPLES);
+    for (size_t channel = 0; channel < cNUMBER_OF_SAMPLES; ++channel)
+    {
+      fusion.UpdateChannel(0, channel, data[channel], keys[channel]);
+      fusion.UpdateChannel(1, channel, data[cNUMBER_OF_SAMPLES - 1 - channel], keys[channel]);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(fusion.IsValid(0) && !fusion.IsValid());
+    for (size_t channel = 0; channel < cNUMBER_OF_SAMPLES; ++channel)
+    {
+      fusion.UpdateChannel(2, channel, data[channel], zero_keys[channel]);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(fusion.IsValid());
+  }
+
+  void BatchedFusion()
+  {
+    double reversed_data[cNUMBER_OF_SAMPLES] = { 0.8, 0.5, 0.2, 0.1, 0.4 };
+    double zero_keys[cNUMBER_OF_SAMPLES] = { 0, 0, 0, 0, 0 };
+
+    tBatchedDataFusion<double> average;
+    FuseBatch(average, data);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, average.FusedValue(0), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, average.FusedValue(1), 1E-6);
+
+    tBatchedDataFusion<double, batch::WeightedAverage> weighted_average;
+    FuseBatch(weighted_average, data);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(FuseValuesUsingWeightedAverage<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), weighted_average.FusedValue(0), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(FuseValuesUsingWeightedAverage<double>(reversed_data, reversed_data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), weighted_average.FusedValue(1), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, weighted_average.FusedValue(2), 1E-6);
+
+    tBatchedDataFusion<double, batch::WeightedSum> weighted_sum;
+    FuseBatch(weighted_sum, data);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(FuseValuesUsingWeightedSum<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), weighted_sum.FusedValue(0), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(FuseValuesUsingWeightedSum<double>(data, data + cNUMBER_OF_SAMPLES, zero_keys, zero_keys + cNUMBER_OF_SAMPLES), weighted_sum.FusedValue(2), 1E-6);
+
+    tBatchedDataFusion<double, batch::MaximumKey> maximum_key;
+    FuseBatch(maximum_key, data);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValue(0), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, maximum_key.FusedValue(1), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, maximum_key.FusedValue(2), 1E-6);
+
+    double high_keys[3] = { 10, 10, 10 };
+    maximum_key.UpdateAllGroups(1, data, high_keys);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, maximum_key.FusedValue(0), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValue(1), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, maximum_key.FusedValue(2), 1E-6);
+    maximum_key.ClearChannels();
+    RRLIB_UNIT_TESTS_ASSERT(!maximum_key.IsValid());
+
+    for (size_t channel = 0; channel < cNUMBER_OF_SAMPLES; ++channel)
+    {
+      maximum_key.UpdateChannel(1, channel, data[channel], keys[channel]);
+    }
+    maximum_key.UpdateChannel(2, 0, data[0], keys[0]);
+    RRLIB_UNIT_TESTS_ASSERT(!maximum_key.IsValid());
+    RRLIB_UNIT_TESTS_ASSERT(maximum_key.IsValid(1));
+    RRLIB_UNIT_TESTS_ASSERT(!maximum_key.ValidGroups()[0] && maximum_key.ValidGroups()[1] && !maximum_key.ValidGroups()[2]);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValue(1), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, maximum_key.FusedValues()[1], 1E-6);
+    RRLIB_UNIT_TESTS_EXCEPTION(maximum_key.FusedValue(2), std::runtime_error);
+    RRLIB_UNIT_TESTS_EXCEPTION(maximum_key.FusedValue(3), std::runtime_error);
+  }
+
+  void SimdKernels()
+  {
+    double samples[41];
+    float float_samples[41];
+    double sample_keys[41];
+    for (size_t i = 0; i < 41; ++i)
+    {
+      samples[i] = 0.1 * ((i * 7) % 13);
+      float_samples[i] = samples[i];
+      sample_keys[i] = double((i * 5) % 11);
+    }
+
+    for (size_t n = 0; n <= 41; ++n)
+    {
+      double sum = 0;
+      double weighted_sum = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        sum += samples[i];
+        weighted_sum += samples[i] * sample_keys[i];
+      }
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(sum, simd::Sum(samples, n), 1E-9);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(sum, simd::Sum(float_samples, n), 1E-5);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(weighted_sum, simd::WeightedSum(samples, sample_keys, n), 1E-9);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(weighted_sum, simd::WeightedSum(float_samples, sample_keys, n), 1E-5);
+      if (n > 0)
+      {
+        size_t arg_max = std::max_element(sample_keys, sample_keys + n) - sample_keys;
+        RRLIB_UNIT_TESTS_EQUALITY(arg_max, simd::ArgMax(sample_keys, n));
+        RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(n > 1 ? weighted_sum / sample_keys[arg_max] : 0.0, simd::MaximumNormalizedWeightedSum(samples, sample_keys, n), 1E-9);
+      }
+    }
+
+    // every variant supported by this CPU, with NaN at each position (or none)
+    const std::vector<simd::internal::tKernels> kernels = simd::internal::SupportedKernels();
+    for (size_t n = 1; n <= 41; ++n)
+    {
+      for (size_t nan_position = 0; nan_position <= n; ++nan_position)
+      {
+        std::vector<double> nan_keys(sample_keys, sample_keys + n);
+        if (nan_position < n)
+        {
+          nan_keys[nan_position] = std::numeric_limits<double>::quiet_NaN();
+        }
+        size_t arg_max = 0;
+        for (size_t k = 1; k < n; ++k)
+        {
+          arg_max = nan_keys[k] > nan_keys[arg_max] ? k : arg_max;
+        }
+        for (auto kernel = kernels.begin(); kernel != kernels.end(); ++kernel)
+        {
+          RRLIB_UNIT_TESTS_EQUALITY(arg_max, kernel->arg_max(nan_keys.data(), n));
+        }
+      }
+    }
+
+    // element-wise kernels compute every element like the scalar loop, NaN keys included (FMA may round once)
+    auto same = [](const std::vector<double> &a, const std::vector<double> &b, double tolerance)
+    {
+      return std::equal(a.begin(), a.end(), b.begin(), [tolerance](double x, double y)
+      {
+        return std::fabs(x - y) <= tolerance * std::fabs(x) || (x != x && y != y);
+      });
+    };
+    for (size_t n = 0; n <= 41; ++n)
+    {
+      std::vector<double> values(samples, samples + n);
+      std::vector<double> nan_keys(sample_keys, sample_keys + n);
+      for (size_t i = 0; i < n; i += 3)
+      {
+        values[i] = -values[i];
+        nan_keys[i] = i % 2 ? std::numeric_limits<double>::quiet_NaN() : -nan_keys[i];
+      }
+      auto run = [&](const simd::internal::tKernels & kernel, std::vector<double> *results)
+      {
+        for (size_t i = 0; i < 6; ++i)
+        {
+          results[i].assign(sample_keys, sample_keys + n);
+          std::reverse(results[i].begin(), results[i].end());
+        }
+        kernel.add_to(results[0].data(), values.data(), n);
+        kernel.multiply_add_to(results[1].data(), values.data(), nan_keys.data(), n);
+        kernel.add_absolute_to(results[2].data(), values.data(), n);
+        kernel.maximum_to(results[3].data(), nan_keys.data(), n);
+        kernel.select_maximum_key(results[4].data(), results[5].data(), nan_keys.data(), values.data(), n);
+      };
+      std::vector<double> expected[6], actual[6];
+      run(simd::internal::ScalarKernels(), expected);
+      for (auto kernel = kernels.begin(); kernel != kernels.end(); ++kernel)
+      {
+        run(*kernel, actual);
+        for (size_t i = 0; i < 6; ++i)
+        {
+          RRLIB_UNIT_TESTS_ASSERT(same(expected[i], actual[i], i == 1 ? 1E-12 : 0));
+        }
+      }
+    }
+
+    tStaticWeightedAverage<float, channel::Dense> weighted_average;
+    weighted_average.SetNumberOfChannels(41);
+    weighted_average.UpdateChannels(0, float_samples, sample_keys, 41);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(FuseValuesUsingWeightedAverage<double>(samples, samples + 41, sample_keys, sample_keys + 41), weighted_average.FusedValue(), 1E-5);
+
+    tStaticMaximumKey<double, channel::Dense> maximum_key;
+    const size_t nan_positions[3][2] = { { 8, 1 }, { 9, 1 }, { 17, 9 } };
+    for (size_t i = 0; i < 3; ++i)
+    {
+      size_t n = nan_positions[i][0];
+      std::vector<double> nan_keys(sample_keys, sample_keys + n);
+      nan_keys[nan_positions[i][1]] = std::numeric_limits<double>::quiet_NaN();
+      size_t arg_max = 0;
+      for (size_t k = 1; k < n; ++k)
+      {
+        arg_max = nan_keys[k] > nan_keys[arg_max] ? k : arg_max;
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(arg_max, simd::ArgMax(nan_keys.data(), n));
+
+      maximum_key.SetNumberOfChannels(n);
+      maximum_key.UpdateChannels(0, samples, nan_keys.data(), n);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(samples[arg_max], maximum_key.FusedValue(), 1E-9);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(FuseValuesUsingMaximumKey<double>(samples, samples + n, nan_keys.begin(), nan_keys.end()), maximum_key.FusedValue(), 1E-9);
+    }
+  }
+
+  void Selection()
+  {
+    for (size_t n = 1; n < 64; ++n)
+    {
+      std::vector<int> values(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        values[i] = (i * 37 + 11) % 17;
+      }
+      std::vector<int> sorted(values);
+      std::sort(sorted.begin(), sorted.end());
+      for (size_t nth = 0; nth < n; nth += 3)
+      {
+        std::vector<int> introselect(values);
+        std::vector<int> median_of_medians(values);
+        selection::Select(introselect.begin(), introselect.begin() + nth, introselect.end(), std::less<int>());
+        selection::Select(median_of_medians.begin(), median_of_medians.begin() + nth, median_of_medians.end(), std::less<int>(), tSelectionAlgorithm::MEDIAN_OF_MEDIANS);
+        RRLIB_UNIT_TESTS_EQUALITY(sorted[nth], introselect[nth]);
+        RRLIB_UNIT_TESTS_EQUALITY(sorted[nth], median_of_medians[nth]);
+        RRLIB_UNIT_TESTS_ASSERT(std::is_permutation(values.begin(), values.end(), median_of_medians.begin()));
+      }
+    }
+
+    tStaticMedianVoter<double> median_voter;
+    tStaticMedianKeyVoter<double> median_key_voter;
+    median_voter.SetSelectionAlgorithm(tSelectionAlgorithm::MEDIAN_OF_MEDIANS);
+    median_key_voter.SetSelectionAlgorithm(tSelectionAlgorithm::MEDIAN_OF_MEDIANS);
+    median_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    median_key_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    median_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+    median_key_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, median_voter.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, median_key_voter.FusedValue(), 1E-6);
+  }
+
+  void MedianNetworks()
+  {
+    // by the 0-1 principle, a network that selects the median of all
+    // binary inputs selects the median of arbitrary inputs
+    for (size_t n = 3; n <= 9; n += 2)
+    {
+      for (unsigned int bits = 0; bits < (1u << n); ++bits)
+      {
+        int values[9];
+        size_t ones = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+          values[i] = (bits >> i) & 1;
+          ones += values[i];
+        }
+        int *median = selection::SelectMedian(values, values + n, std::less<int>());
+        RRLIB_UNIT_TESTS_EQUALITY(values + n / 2, median);
+        RRLIB_UNIT_TESTS_EQUALITY(ones > n / 2 ? 1 : 0, *median);
+      }
+    }
+
+    tFixedMedianVoter<double, 3> median_voter;
+    tFixedMedianKeyVoter<double, 3> median_key_voter;
+    median_voter.UpdateAllChannels(data, data + 3);
+    median_key_voter.UpdateAllChannels(data, data + 3, keys, keys + 3);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, median_voter.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, median_key_voter.FusedValue(), 1E-6);
+  }
+
+  void AveragingChannel()
+  {
+    tStaticAverage<double, channel::StaticAverage> fusion;
+    fusion.SetNumberOfChannels(2);
+    for (size_t i = 0; i < cNUMBER_OF_SAMPLES; ++i)
+    {
+      fusion.UpdateChannel(0, data[i], keys[i]);
+    }
+    fusion.UpdateChannel(1, 0.6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, fusion.FusedValue(), 1E-6);
+
+    fusion.EnterNextTimestep();
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid());
+    fusion.UpdateChannel(0, 0.2);
+    fusion.UpdateChannel(1, 0.4);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, fusion.FusedValue(), 1E-6);
+
+    channel::Average<double> channel;
+    channel.AddSample(0.1, 2);
+    channel.AddSample(0.3, 4);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, channel.GetSample(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(3.0, channel.GetKey(), 1E-6);
+  }
+
+  void RunningMedian()
+  {
+    tRunningMedian<int> median;
+    std::vector<int> values;
+    for (size_t i = 0; i < 100; ++i)
+    {
+      int value = (i * 37 + 11) % 23;
+      median.Add(value);
+      values.push_back(value);
+      std::vector<int> sorted(values);
+      std::sort(sorted.begin(), sorted.end());
+      RRLIB_UNIT_TESTS_EQUALITY(sorted[sorted.size() / 2], median.Median());
+    }
+
+    channel::StaticMedian<double> channel;
+    for (size_t i = 0; i < cNUMBER_OF_SAMPLES; ++i)
+    {
+      channel.AddSample(data[i], keys[i]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, channel.GetSample(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(3.0, channel.GetKey(), 1E-6);
+    channel.PrepareForNextTimestep();
+    RRLIB_UNIT_TESTS_ASSERT(!channel.IsValid());
+
+    channel::StaticMedian<math::tPose2D> pose_channel;
+    for (size_t i = 0; i < cNUMBER_OF_SAMPLES; ++i)
+    {
+      pose_channel.AddSample(math::tPose2D(data[i], data[i], math::tAngleRad(data[i])), keys[i]);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(IsEqual(math::tPose2D(0.4, 0.4, math::tAngleRad(0.4)), pose_channel.GetSample()));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(3.0, pose_channel.GetKey(), 1E-6);
+  }
+
+  void QuantileEstimation()
+  {
+    tQuantileEstimator median;
+    tQuantileEstimator upper_decile(0.9);
+    uint32_t state = 1;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      state = state * 1664525 + 1013904223;
+      double value = state / 4294967296.0;
+      median.Add(value);
+      upper_decile.Add(value);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, median.Quantile(), 0.02);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.9, upper_decile.Quantile(), 0.02);
+
+    tStaticMedianVoter<double, channel::StaticApproximateMedian> fusion;
+    fusion.SetNumberOfChannels(1);
+    for (size_t i = 0; i < cNUMBER_OF_SAMPLES - 1; ++i)
+    {
+      fusion.UpdateChannel(0, data[i], keys[i]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, fusion.FusedValue(), 1E-6);
+
+    channel::Quantile<std::ratio<9, 10>>::StaticPolicy<double> channel;
+    for (size_t i = 0; i <= 100; ++i)
+    {
+      channel.AddSample(i, 1);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(90.0, channel.GetSample(), 1.0);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(1.0, channel.GetKey(), 1E-6);
+  }
+
+  void SlidingWindow()
+  {
+    tStaticAverage<double, channel::SlidingWindow<3>::StaticAverage> average;
+    tStaticAverage<double, channel::SlidingWindow<3>::StaticMedian> median;
+    average.SetNumberOfChannels(1);
+    median.SetNumberOfChannels(1);
+    for (size_t i = 0; i < cNUMBER_OF_SAMPLES; ++i)
+    {
+      average.UpdateChannel(0, data[i], keys[i]);
+      median.UpdateChannel(0, data[i], keys[i]);
+      average.EnterNextTimestep();
+      median.EnterNextTimestep();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, average.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, median.FusedValue(), 1E-6);
+
+    channel::SlidingWindow<4>::Average<double> channel;
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      channel.AddSample(i % 4 + 0.1, keys[i % cNUMBER_OF_SAMPLES]);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(1.6, channel.GetSample(), 1E-12);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(3.0, channel.GetKey(), 1E-12);
+
+    channel::SlidingTimeWindow<8, std::ratio<1, 1000>>::StaticMedian<double> time_window;
+    time_window.AddSample(0.1, 1);
+    time_window.AddSample(0.2, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    time_window.AddSample(0.8, 1);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.8, time_window.GetSample(), 1E-6);
+
+    tStaticAverage<double, channel::SlidingTimeWindow<8, std::ratio<1, 100>>::StaticAverage> time_average;
+    tStaticIncrementalAverage<double, channel::SlidingTimeWindow<8, std::ratio<1, 100>>::StaticAverage> incremental_time_average;
+    time_average.SetNumberOfChannels(1);
+    incremental_time_average.SetNumberOfChannels(1);
+    time_average.UpdateChannel(0, 0.2);
+    time_average.UpdateChannel(0, 0.8);
+    incremental_time_average.UpdateChannel(0, 0.2);
+    incremental_time_average.UpdateChannel(0, 0.8);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, time_average.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, incremental_time_average.FusedValue(), 1E-6);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, time_average.FusedValue(), 1E-6);
+    time_average.EnterNextTimestep();
+    incremental_time_average.EnterNextTimestep();
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.8, time_average.FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.8, incremental_time_average.FusedValue(), 1E-6);
+
+    channel::SlidingWindow<3>::StaticMedian<double> nan_median;
+    const double nan_samples[6] = { 0.4, std::numeric_limits<double>::quiet_NaN(), 0.1, 0.2, 0.6, 0.3 };
+    for (size_t i = 0; i < 6; ++i)
+    {
+      nan_median.AddSample(nan_samples[i], nan_samples[i]);
+      if (i == 3)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, nan_median.GetSample(), 1E-6);
+      }
+    }
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, nan_median.GetSample(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, nan_median.GetKey(), 1E-6);
+  }
+
+  void ExponentialAverage()
+  {
+    tStaticAverage<double, channel::ExponentialAverage<std::ratio<1, 4>>::StaticPolicy> fusion;
+    fusion.SetNumberOfChannels(1);
+    fusion.UpdateChannel(0, 0.8, 2);
+    fusion.EnterNextTimestep();
+    fusion.UpdateChannel(0, 0.4, 6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.7, fusion.FusedValue(), 1E-6);
+
+    channel::ExponentialAverage<std::ratio<1, 4>>::Policy<double> channel;
+    channel.AddSample(0.8, 2);
+    channel.AddSample(0.4, 6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(3.0, channel.GetKey(), 1E-6);
+    channel.ClearData();
+    RRLIB_UNIT_TESTS_ASSERT(!channel.IsValid());
+    channel.AddSample(0.1, 1);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, channel.GetSample(), 1E-6);
+
+#ifdef _LIB_RRLIB_MATH_PRESENT_
+    channel::ExponentialAverage<std::ratio<1, 2>>::StaticPolicy<math::tPose2D> pose_channel;
+    pose_channel.AddSample(math::tPose2D(0.2, 0.4, math::tAngleRad(0.2)), 1);
+    pose_channel.AddSample(math::tPose2D(0.4, 0.2, math::tAngleRad(0.4)), 1);
+    RRLIB_UNIT_TESTS_ASSERT(IsEqual(math::tPose2D(0.3, 0.3, math::tAngleRad(0.3)), pose_channel.GetSample()));
+#endif
+  }
+
+  void ChannelExpiry()
+  {
+    typedef tExpiringDataFusion<tStaticAverage<double>>::tTimestamp tTimestamp;
+    typedef std::chrono::milliseconds ms;
+    const tTimestamp start;
+
+    tExpiringDataFusion<tStaticAverage<double>> fusion(3, ms(50));
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid(start));
+    fusion.UpdateChannel(0, 0.2, 1, start);
+    fusion.UpdateChannel(1, 0.4, 1, start + ms(10));
+    fusion.UpdateChannel(2, 0.6, 1, start + ms(20));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, fusion.FusedValue(start + ms(30)), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, fusion.FusedValue(start + ms(55)), 1E-6);
+
+    fusion.UpdateChannel(0, 0.8, 1, start + ms(60));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.7, fusion.FusedValue(start + ms(61)), 1E-6);
+    fusion.UpdateChannel(2, 0.2, 1, start + ms(62));
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, fusion.Fusion().FusedValue(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, fusion.FusedValue(start + ms(63)), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(2), fusion.NumberOfValidChannels(start + ms(63)));
+
+    fusion.SetMinimumNumberOfChannels(3);
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid(start + ms(63)));
+    fusion.SetMinimumNumberOfChannels(1);
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.IsValid(start + ms(200)));
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(0), fusion.NumberOfValidChannels(start + ms(200)));
+
+    // channels with update periods around the maximum age keep expiring and returning
+    tExpiringDataFusion<tStaticAverage<double>> flapping(cNUMBER_OF_SAMPLES, ms(10));
+    tTimestamp last_update[cNUMBER_OF_SAMPLES];
+    double last_sample[cNUMBER_OF_SAMPLES];
+    for (size_t step = 0; step < 200; ++step)
+    {
+      tTimestamp now = start + ms(step);
+      for (size_t channel = 0; channel < cNUMBER_OF_SAMPLES; ++channel)
+      {
+        if (step % (4 * channel + 4) == 0)
+        {
+          last_update[channel] = now;
+          last_sample[channel] = keys[channel] + step;
+          flapping.UpdateChannel(channel, last_sample[channel], 1, now);
+        }
+      }
+      double sum = 0;
+      size_t number_of_fresh_channels = 0;
+      for (size_t channel = 0; channel < cNUMBER_OF_SAMPLES; ++channel)
+      {
+        if (now - last_update[channel] <= ms(10))
+        {
+          sum += last_sample[channel];
+          number_of_fresh_channels++;
+        }
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(number_of_fresh_channels, flapping.NumberOfValidChannels(now));
+      RRLIB_UNIT_TESTS_EQUALITY(number_of_fresh_channels, flapping.Fusion().NumberOfChannels());
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(sum / number_of_fresh_channels, flapping.FusedValue(now), 1E-9);
+    }
+  }
+
+  struct tCountingResource : public tMemoryResource
+  {
+    size_t number_of_allocations = 0;
+
+    virtual void *Allocate(size_t size, size_t alignment)
+    {
+      this->number_of_allocations++;
+      return NewDeleteResource().Allocate(size, alignment);
+    }
+
+    virtual void Deallocate(void *pointer, size_t size, size_t alignment)
+    {
+      NewDeleteResource().Deallocate(pointer, size, alignment);
+    }
+  };
+
+  void MemoryResources()
+  {
+    tCountingResource upstream;
+    tMonotonicBufferResource arena(upstream);
+    for (size_t cycle = 0; cycle < 3; ++cycle)
+    {
+      size_t number_of_allocations = upstream.number_of_allocations;
+      {
+        tScopedMemoryResource scope(arena);
+        RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, FuseValuesUsingMedianVoter<double>(data, data + cNUMBER_OF_SAMPLES), 1E-6);
+        RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, FuseValuesUsingMedianKeyVoter<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), 1E-6);
+      }
+      arena.Release();
+      if (cycle > 0)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY(number_of_allocations, upstream.number_of_allocations);
+      }
+    }
+    RRLIB_UNIT_TESTS_ASSERT(&GetDefaultMemoryResource() == &NewDeleteResource());
+
+    alignas(16) char buffer[4096];
+    tMonotonicBufferResource stack_arena(buffer, sizeof(buffer), upstream);
+    size_t number_of_allocations = upstream.number_of_allocations;
+    {
+      tScopedMemoryResource scope(stack_arena);
+      tStaticMedianVoter<double> median_voter;
+      median_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+      median_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, median_voter.FusedValue(), 1E-6);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(number_of_allocations, upstream.number_of_allocations);
+  }
+
+  struct tFailingResource : public tMemoryResource
+  {
+    bool fail = false;
+
+    virtual void *Allocate(size_t size, size_t alignment)
+    {
+      if (this->fail)
+      {
+        throw std::bad_alloc();
+      }
+      return NewDeleteResource().Allocate(size, alignment);
+    }
+
+    virtual void Deallocate(void *pointer, size_t size, size_t alignment)
+    {
+      NewDeleteResource().Deallocate(pointer, size, alignment);
+    }
+  };
+
+  void NoexceptInterface()
+  {
+    tStaticAverage<double> fusion;
+    static_assert(noexcept(fusion.TryUpdateChannel(0, 0.0)) && noexcept(fusion.TryFusedValue()), "Try methods must be noexcept");
+
+    RRLIB_UNIT_TESTS_ASSERT(fusion.Status() == tFusionStatus::NO_CHANNELS);
+    RRLIB_UNIT_TESTS_ASSERT(fusion.TryFusedValue().Status() == tFusionStatus::NO_CHANNELS);
+    fusion.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_ASSERT(fusion.TryUpdateChannel(cNUMBER_OF_SAMPLES, 1.0) == tFusionStatus::CHANNEL_OUT_OF_RANGE);
+    RRLIB_UNIT_TESTS_ASSERT(fusion.TryUpdateChannel(0, data[0]) == tFusionStatus::OK);
+    RRLIB_UNIT_TESTS_ASSERT(!fusion.TryFusedValue());
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(-1.0, fusion.TryFusedValue().ValueOr(-1.0), 1E-6);
+    RRLIB_UNIT_TESTS_ASSERT(fusion.TryUpdateChannels(1, data + 1, 0, cNUMBER_OF_SAMPLES) == tFusionStatus::CHANNEL_OUT_OF_RANGE);
+    RRLIB_UNIT_TESTS_ASSERT(fusion.TryUpdateChannels(1, data + 1, 0, cNUMBER_OF_SAMPLES - 1) == tFusionStatus::OK);
+    tFusionResult<double> result = fusion.TryFusedValue();
+    RRLIB_UNIT_TESTS_ASSERT(result && result.Status() == tFusionStatus::OK);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, result.Value(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(fusion.FusedValue(), result.Value(), 1E-6);
+
+    channel::StaticLastValue<double> channel;
+    RRLIB_UNIT_TESTS_ASSERT(channel.TryGetSample().Status() == tFusionStatus::INVALID_CHANNEL);
+    channel.AddSample(0.3, 2);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, channel.TryGetSample().Value(), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(2.0, channel.TryGetKey().Value(), 1E-6);
+
+    tFailingResource resource;
+    tScopedMemoryResource scope(resource);
+    tStaticAverage<double, channel::StaticMedian> median_channels;
+    median_channels.SetNumberOfChannels(2);
+    RRLIB_UNIT_TESTS_ASSERT(median_channels.TryUpdateChannels(0, data, 0, 2) == tFusionStatus::OK);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.25, median_channels.TryFusedValue().Value(), 1E-6);
+    resource.fail = true;
+    RRLIB_UNIT_TESTS_ASSERT(median_channels.TryUpdateChannel(1, 0.3) == tFusionStatus::OUT_OF_MEMORY);
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(1), median_channels.NumberOfValidChannels());
+    RRLIB_UNIT_TESTS_ASSERT(median_channels.TryFusedValue().Status() == tFusionStatus::INVALID_STATE);
+    resource.fail = false;
+    RRLIB_UNIT_TESTS_ASSERT(median_channels.TryUpdateChannel(1, 0.3) == tFusionStatus::OK);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.35, median_channels.TryFusedValue().Value(), 1E-6);
+
+    tStaticMedianVoter<double> median_voter;
+    median_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_ASSERT(median_voter.TryUpdateChannels(0, data, 0, cNUMBER_OF_SAMPLES) == tFusionStatus::OK);
+    resource.fail = true;
+    RRLIB_UNIT_TESTS_ASSERT(median_voter.TryFusedValue().Status() == tFusionStatus::OUT_OF_MEMORY);
+    resource.fail = false;
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, median_voter.TryFusedValue().Value(), 1E-6);
+  }
+
+  void InjectedMemoryResources()
+  {
+    tCountingResource resource;
+    tFailingResource default_resource;
+    default_resource.fail = true;
+    tScopedMemoryResource scope(default_resource);
+
+    tStaticMedianVoter<double, channel::StaticMedian> median_voter(resource);
+    tStaticIncrementalAverage<double> incremental_average(resource);
+    tBatchedDataFusion<double, batch::WeightedAverage> batched(2, cNUMBER_OF_SAMPLES, resource);
+    tExpiringDataFusion<tStaticMedianKeyVoter<double>> expiring(cNUMBER_OF_SAMPLES, std::chrono::seconds(1), resource);
+    tConcurrentDataFusion<tStaticAverage<double>> concurrent(cNUMBER_OF_SAMPLES, resource);
+    median_voter.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    incremental_average.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+
+    // the scratch of the median voter is taken from its arena, which is released every timestep
+    size_t number_of_allocations = 0;
+    for (size_t cycle = 0; cycle < 50; ++cycle)
+    {
+      median_voter.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, median_voter.FusedValue(), 1E-6);
+      incremental_average.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, incremental_average.FusedValue(), 1E-6);
+      for (size_t channel = 0; channel < cNUMBER_OF_SAMPLES; ++channel)
+      {
+        double group_samples[2] = { data[channel], data[channel] };
+        double group_keys[2] = { keys[channel], keys[channel] };
+        batched.UpdateAllGroups(channel, group_samples, group_keys);
+        expiring.UpdateChannel(channel, data[channel], keys[channel]);
+        concurrent.UpdateChannel(channel, data[channel]);
+      }
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, batched.FusedValue(1), 1E-6);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, expiring.FusedValue(), 1E-6);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, concurrent.FusedValue(), 1E-6);
+      median_voter.EnterNextTimestep();
+      incremental_average.EnterNextTimestep();
+      concurrent.EnterNextTimestep();
+      if (cycle > 0)
+      {
+        RRLIB_UNIT_TESTS_EQUALITY(number_of_allocations, resource.number_of_allocations);
+      }
+      number_of_allocations = resource.number_of_allocations;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(number_of_allocations > 0);
+  }
+
+  void Kernels()
+  {
+    double scratch[cNUMBER_OF_SAMPLES];
+    kernels::tIndexedKey indexed_keys[cNUMBER_OF_SAMPLES];
+
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.1, kernels::MaximumKey<double>(data, data + cNUMBER_OF_SAMPLES, keys), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, kernels::Average<double>(data, data + cNUMBER_OF_SAMPLES), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.3, kernels::WeightedAverage<double>(data, data + cNUMBER_OF_SAMPLES, keys), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, kernels::Median<double>(data, data + cNUMBER_OF_SAMPLES, scratch), 1E-6);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.4, data[0], 1E-6);
+    size_t median_key = kernels::MedianKeyIndex(keys, keys + cNUMBER_OF_SAMPLES, indexed_keys);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.2, data[median_key], 1E-6);
+
+    tStaticWeightedSum<double> weighted_sum;
+    weighted_sum.SetNumberOfChannels(cNUMBER_OF_SAMPLES);
+    weighted_sum.UpdateAllChannels(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(kernels::WeightedSum<double>(data, data + cNUMBER_OF_SAMPLES, keys), weighted_sum.FusedValue(), 1E-12);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(weighted_sum.FusedValue(), FuseValuesUsingWeightedSum<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES), 1E-12);
+
+    std::vector<double> samples(101), sample_keys(101);
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+      samples[i] = (i * 37 % 101) * 0.01;
+      sample_keys[i] = (i * 53 % 101) * 0.1;
+    }
+    tStaticMedianVoter<double> median_voter;
+    median_voter.SetNumberOfChannels(samples.size());
+    median_voter.UpdateAllChannels(samples.begin(), samples.end());
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, FuseValuesUsingMedianVoter<double>(samples.begin(), samples.end()), 1E-9);
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(median_voter.FusedValue(), FuseValuesUsingMedianVoter<double>(samples.begin(), samples.end()), 1E-12);
+    tStaticMedianKeyVoter<double> median_key_voter;
+    median_key_voter.SetNumberOfChannels(samples.size());
+    median_key_voter.UpdateAllChannels(samples.begin(), samples.end(), sample_keys.begin(), sample_keys.end());
+    RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(median_key_voter.FusedValue(), FuseValuesUsingMedianKeyVoter<double>(samples.begin(), samples.end(), sample_keys.begin(), sample_keys.end()), 1E-12);
+
+    std::vector<double> median_scratch(samples.size());
+    std::vector<kernels::tIndexedKey> median_key_scratch(samples.size());
+    tCountingResource resource;
+    {
+      tScopedMemoryResource scope(resource);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(0.5, FuseValuesUsingMedianVoter<double>(samples.begin(), samples.end(), median_scratch.begin(), median_scratch.end()), 1E-9);
+      RRLIB_UNIT_TESTS_EQUALITY_DOUBLE(median_key_voter.FusedValue(), FuseValuesUsingMedianKeyVoter<double>(samples.begin(), samples.end(), sample_keys.begin(), sample_keys.end(), median_key_scratch.begin(), median_key_scratch.end()), 1E-12);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(size_t(0), resource.number_of_allocations);
+    RRLIB_UNIT_TESTS_EXCEPTION(FuseValuesUsingMedianVoter<double>(samples.begin(), samples.end(), median_scratch.begin(), median_scratch.end() - 1), std::logic_error);
+
+    bool mismatch_detected = false;
+    try
+    {
+      FuseValuesUsingWeightedAverage<double>(data, data + cNUMBER_OF_SAMPLES, keys, keys + cNUMBER_OF_SAMPLES - 1);
+    }
+    catch (const std::runtime_error &)
+    {
+      mismatch_detected = true;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(mismatch_detected);
+  }
 };
 
 RRLIB_UNIT_TESTS_REGISTER_SUITE(Test);
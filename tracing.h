@@ -0,0 +1,367 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tracing.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Event tracing of fusion objects with Chrome trace export
+ *
+ * When RRLIB_DATA_FUSION_TRACING is defined, fusion objects record begin
+ * and end events of their operations, tagged with their log description
+ * and the channel index. Every thread writes into its own ring buffer
+ * without locking, the buffer only keeps the most recent events.
+ * WriteChromeTrace dumps the buffers of all threads in the trace event
+ * format of chrome://tracing and Perfetto.
+ *
+ * The channel policies record one event pair per sample. As this quickly
+ * displaces all other events, they are only traced if
+ * RRLIB_DATA_FUSION_TRACING_CHANNELS is defined as well.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__data_fusion__tracing_h__
+#define __rrlib__data_fusion__tracing_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace data_fusion
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+#ifdef RRLIB_DATA_FUSION_TRACING
+#define RRLIB_DATA_FUSION_TRACE(name, description) rrlib::data_fusion::tracing::tScope trace_scope(name, description, rrlib::data_fusion::tracing::cNO_CHANNEL)
+#define RRLIB_DATA_FUSION_TRACE_CHANNEL(name, description, channel) rrlib::data_fusion::tracing::tScope trace_scope(name, description, channel)
+#else
+#define RRLIB_DATA_FUSION_TRACE(name, description)
+#define RRLIB_DATA_FUSION_TRACE_CHANNEL(name, description, channel)
+#endif
+
+#if defined(RRLIB_DATA_FUSION_TRACING) && defined(RRLIB_DATA_FUSION_TRACING_CHANNELS)
+#define RRLIB_DATA_FUSION_TRACE_CHANNEL_POLICY(name) RRLIB_DATA_FUSION_TRACE(name, "channel")
+#else
+#define RRLIB_DATA_FUSION_TRACE_CHANNEL_POLICY(name)
+#endif
+
+namespace tracing
+{
+
+const size_t cNO_CHANNEL = static_cast<size_t>(-1);
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+/*! Name and description must be string literals or otherwise outlive
+ *  the export of the trace.
+ */
+struct tEvent
+{
+  const char *name;
+  const char *description;
+  uint64_t timestamp;
+  size_t channel;
+  char phase;
+};
+
+//! Ring buffer of the events of one thread
+/*! Only the owning thread records, any thread may read. Every slot
+ *  carries a sequence number that tells which event it holds and whether
+ *  it is being written, so events that were overwritten or only partly
+ *  written while they were read are dropped.
+ */
+class tBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  static const size_t cCAPACITY = 1 << 14;
+
+  explicit tBuffer(size_t thread_id)
+    : thread_id(thread_id),
+      slots(new tSlot[cCAPACITY]),
+      begin(0),
+      end(0)
+  {}
+
+  inline size_t ThreadId() const
+  {
+    return this->thread_id;
+  }
+
+  inline void Record(const char *name, const char *description, size_t channel, char phase)
+  {
+    uint64_t index = this->end.load(std::memory_order_relaxed);
+    tSlot &slot = this->slots[index & (cCAPACITY - 1)];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.description.store(description, std::memory_order_relaxed);
+    slot.timestamp.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+    slot.channel.store(channel, std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    this->end.store(index + 1, std::memory_order_release);
+  }
+
+  //! Appends the retained events to events, oldest first
+  void Read(std::vector<tEvent> &events) const
+  {
+    uint64_t end = this->end.load(std::memory_order_acquire);
+    uint64_t begin = std::max(this->begin.load(std::memory_order_relaxed), end > cCAPACITY ? end - cCAPACITY : 0);
+    for (uint64_t i = begin; i < end; ++i)
+    {
+      const tSlot &slot = this->slots[i & (cCAPACITY - 1)];
+      uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence != 2 * i + 2)
+      {
+        continue;
+      }
+      tEvent event;
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.description = slot.description.load(std::memory_order_relaxed);
+      event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+      event.channel = slot.channel.load(std::memory_order_relaxed);
+      event.phase = slot.phase.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+      {
+        events.push_back(event);
+      }
+    }
+  }
+
+  inline void Clear()
+  {
+    this->begin.store(this->end.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! The sequence number of event i is 2i + 1 while it is written and
+   *  2i + 2 when it is complete
+   */
+  struct tSlot
+  {
+    tSlot()
+      : sequence(0),
+        name(nullptr),
+        description(nullptr),
+        timestamp(0),
+        channel(0),
+        phase(0)
+    {}
+
+    std::atomic<uint64_t> sequence;
+    std::atomic<const char *> name;
+    std::atomic<const char *> description;
+    std::atomic<uint64_t> timestamp;
+    std::atomic<size_t> channel;
+    std::atomic<char> phase;
+  };
+
+  size_t thread_id;
+  std::unique_ptr<tSlot[]> slots;
+  std::atomic<uint64_t> begin;
+  std::atomic<uint64_t> end;
+
+};
+
+namespace internal
+{
+
+/*! The registry shares ownership of the buffers, so the events of
+ *  threads that already terminated remain available for export.
+ */
+struct tRegistry
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<tBuffer>> buffers;
+};
+
+inline tRegistry &Registry()
+{
+  static tRegistry registry;
+  return registry;
+}
+
+inline std::shared_ptr<tBuffer> CreateBuffer()
+{
+  tRegistry &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.buffers.push_back(std::make_shared<tBuffer>(registry.buffers.size()));
+  return registry.buffers.back();
+}
+
+inline void WriteString(std::ostream &stream, const char *string)
+{
+  stream << '"';
+  for (; *string; ++string)
+  {
+    if (*string == '"' || *string == '\\')
+    {
+      stream << '\\';
+    }
+    if (static_cast<unsigned char>(*string) >= 0x20)
+    {
+      stream << *string;
+    }
+  }
+  stream << '"';
+}
+
+}
+
+//! The buffer of the calling thread, registered on first use
+inline tBuffer &ThreadBuffer()
+{
+  static thread_local std::shared_ptr<tBuffer> buffer = internal::CreateBuffer();
+  return *buffer;
+}
+
+//! Records a begin event on construction and the matching end event on destruction
+class tScope
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tScope(const char *name, const char *description, size_t channel)
+    : buffer(ThreadBuffer()),
+      name(name),
+      description(description),
+      channel(channel)
+  {
+    this->buffer.Record(name, description, channel, 'B');
+  }
+
+  ~tScope()
+  {
+    this->buffer.Record(this->name, this->description, this->channel, 'E');
+  }
+
+  tScope(const tScope &) = delete;
+  tScope &operator = (const tScope &) = delete;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tBuffer &buffer;
+  const char *name;
+  const char *description;
+  size_t channel;
+
+};
+
+//----------------------------------------------------------------------
+// Function declaration
+//----------------------------------------------------------------------
+//! Discards the recorded events of all threads
+inline void Clear()
+{
+  internal::tRegistry &registry = internal::Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto it = registry.buffers.begin(); it != registry.buffers.end(); ++it)
+  {
+    (*it)->Clear();
+  }
+}
+
+/*! Writes the recorded events of all threads as Chrome trace event JSON.
+ *  Timestamps are microseconds of std::chrono::steady_clock.
+ */
+inline void WriteChromeTrace(std::ostream &stream)
+{
+  internal::tRegistry &registry = internal::Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::vector<tEvent> events;
+  bool first = true;
+  stream << "{\"traceEvents\":[";
+  for (auto buffer = registry.buffers.begin(); buffer != registry.buffers.end(); ++buffer)
+  {
+    events.clear();
+    (*buffer)->Read(events);
+    for (auto event = events.begin(); event != events.end(); ++event)
+    {
+      stream << (first ? "\n" : ",\n") << "{\"name\":";
+      internal::WriteString(stream, event->name);
+      stream << ",\"cat\":";
+      internal::WriteString(stream, event->description);
+      stream << ",\"ph\":\"" << event->phase << "\",\"ts\":" << event->timestamp / 1000 << '.';
+      uint64_t fraction = event->timestamp % 1000;
+      stream << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "") << fraction;
+      stream << ",\"pid\":1,\"tid\":" << (*buffer)->ThreadId();
+      if (event->channel != cNO_CHANNEL)
+      {
+        stream << ",\"args\":{\"channel\":" << event->channel << "}";
+      }
+      stream << "}";
+      first = false;
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+#endif